@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 /**
  * @file
  * The declarations in this file are released to DspAL users and are used to
@@ -76,6 +78,14 @@
  * Use ioctl() to configure GPIO device as an interrupt source. Users can
  * regsiter and de-register interrupt service handler through ioctl argument.
  *
+ * @par Fast access to a GPIO output port
+ * Use ioctl() with DSPAL_GPIO_IOCTL_GET_FAST_HANDLE to obtain a handle to the
+ * register backing a GPIO device configured in general purpose I/O mode.  The
+ * dspal_gpio_fast_*() functions use the handle to set, clear, toggle and read
+ * the I/O line directly, bypassing the file descriptor lookup and argument
+ * validation performed by read() and write().  This is intended for bit-banged
+ * protocols and timing markers.
+ *
  * @par
  * Sample source code for read/write data to a GPIO device and using GPIO
  * as interrupt source  is included below:
@@ -176,6 +186,7 @@ enum DSPAL_GPIO_IOCTLS {
 	DSPAL_GPIO_IOCTL_CONFIG_IO,    /**< configure GPIO device into general purpose I/O mode */
 	DSPAL_GPIO_IOCTL_CONFIG_REG_INT,   /**< configure GPIO device into interrupt mode */
 	DSPAL_GPIO_IOCTL_CONFIG_DEREG_INT,   /**< configure GPIO device into interrupt mode. No argument required for this option */
+	DSPAL_GPIO_IOCTL_GET_FAST_HANDLE,   /**< return a handle for direct access to the I/O line, see struct dspal_gpio_fast_handle */
 	DSPAL_GPIO_IOCTL_MAX_NUM,      /**< number of valid IOCTL codes defined for the GPIO */
 };
 
@@ -217,3 +228,62 @@ struct dspal_gpio_ioctl_reg_int {
 	DSPAL_GPIO_INT_ISR isr; /**< ISR functor */
 	DSPAL_GPIO_INT_ISR_CTX isr_ctx;  /**< the context argument passed to isr */
 };
+
+/**
+ * @brief
+ * Structure passed to the DSPAL_GPIO_IOCTL_GET_FAST_HANDLE IOCTL call.  On return
+ * it describes the hardware register holding the input and output value of the
+ * I/O line, to be used with the dspal_gpio_fast_*() functions below.
+ *
+ * The GPIO device must already be configured in general purpose I/O mode with
+ * DSPAL_GPIO_IOCTL_CONFIG_IO, otherwise the IOCTL call fails.  All checks are done
+ * once when the handle is created, none are done when the handle is used.  The
+ * handle is valid until the GPIO device is closed and must not be used after that.
+ *
+ * Each I/O line has a dedicated register, so handles for different GPIO devices
+ * can be used concurrently from different threads without locking.
+ */
+struct dspal_gpio_fast_handle {
+	volatile uint32_t *in_out_reg; /**< mapped address of the register holding the value of the I/O line */
+	uint32_t in_mask;              /**< bit in *in_out_reg reflecting the current level of the I/O line */
+	uint32_t out_mask;             /**< bit in *in_out_reg driving the I/O line, 0 if configured as INPUT */
+};
+
+/**
+ * @brief
+ * Drive the output HIGH using a handle returned by DSPAL_GPIO_IOCTL_GET_FAST_HANDLE.
+ */
+static inline void dspal_gpio_fast_set(const struct dspal_gpio_fast_handle *handle)
+{
+	*handle->in_out_reg = handle->out_mask;
+}
+
+/**
+ * @brief
+ * Drive the output LOW using a handle returned by DSPAL_GPIO_IOCTL_GET_FAST_HANDLE.
+ */
+static inline void dspal_gpio_fast_clear(const struct dspal_gpio_fast_handle *handle)
+{
+	*handle->in_out_reg = 0;
+}
+
+/**
+ * @brief
+ * Invert the output using a handle returned by DSPAL_GPIO_IOCTL_GET_FAST_HANDLE.
+ * The register is read and written back, so the same I/O line must not be
+ * toggled from more than one thread at a time.
+ */
+static inline void dspal_gpio_fast_toggle(const struct dspal_gpio_fast_handle *handle)
+{
+	*handle->in_out_reg = (*handle->in_out_reg & handle->out_mask) ^ handle->out_mask;
+}
+
+/**
+ * @brief
+ * Read the current level of the I/O line using a handle returned by
+ * DSPAL_GPIO_IOCTL_GET_FAST_HANDLE.
+ */
+static inline enum DSPAL_GPIO_VALUE_TYPE dspal_gpio_fast_read(const struct dspal_gpio_fast_handle *handle)
+{
+	return (*handle->in_out_reg & handle->in_mask) ? DSPAL_GPIO_HIGH_VALUE : DSPAL_GPIO_LOW_VALUE;
+}
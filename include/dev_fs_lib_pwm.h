@@ -34,6 +34,8 @@
 
 #include <stdint.h>
 
+#include "noarch/dspal_dshot.h"
+
 /**
  * @file
  * The functions in this module define the interface for configuring one
@@ -44,7 +46,34 @@
  * The width of PWM signals specified by the caller can be changed for
  * individual I/O lines, but all I/O lines must have the same period.
  * Additional instances of this device can be opened to define a different group
- * of PWM signals at a different period.
+ * of PWM signals at a different period, e.g. 400 Hz for ESC's and 50 Hz for servos.
+ * Up to DEV_FS_PWM_MAX_NUM_GROUPS groups can be active at the same time, each
+ * with up to DEV_FS_PWM_MAX_NUM_SIGNALS signals.  A GPIO can only be used by one
+ * group at a time.
+ *
+ * Each group is driven by a single timer, which is programmed for the next edge of
+ * any signal in the group.  Signals with the same pulse width share one timer expiry,
+ * so adding signals to a group does not add timers.
+ *
+ * @par
+ * The pulse widths can be updated one signal at a time using the buffer returned by
+ * PWM_IOCTL_GET_UPDATE_BUFFER, or all at once using the buffer returned by
+ * PWM_IOCTL_GET_COMMIT_BUFFER.  Only the latter guarantees that every signal switches
+ * to its new pulse width in the same period.
+ *
+ * @par
+ * A group can instead send DShot frames to digital ESC's, selected by PWM_IOCTL_SET_OUTPUT_MODE
+ * before the signal definition.  The period of the signal definition is then the interval
+ * between frames, e.g. 250 usecs for a 4 kHz update rate, and the frames are written to the
+ * buffer returned by PWM_IOCTL_GET_COMMIT_BUFFER.  The frames of all signals of the group are
+ * sent together, bit by bit, so the time taken to send them does not depend on the number
+ * of signals.
+ *
+ * @par
+ * For OneShot and Multishot ESC's the pulses can instead be triggered by the caller, so that
+ * a new pulse width reaches the ESC's as soon as it is computed instead of at the next period
+ * boundary.  In these modes PWM_IOCTL_TRIGGER starts the pulses of all signals at once, using
+ * the pulse widths of the last commit.
  *
  * @par
  * Sample source code to generate a time varying PWM signal is included below.
@@ -55,14 +84,21 @@
  * @brief
  * The maximum number of pwm signals allowed in a signal definition.
  */
-#define DEV_FS_PWM_MAX_NUM_SIGNALS 8
+#define DEV_FS_PWM_MAX_NUM_SIGNALS 16
+
+/**
+ * @brief
+ * The maximum number of PWM devices, each defining a group of signals with its own
+ * period, that can be open at the same time.
+ */
+#define DEV_FS_PWM_MAX_NUM_GROUPS 4
 
 /**
  * @brief
  * The PWM device path uses the following format:
- * /dev/pwm-{gpio pin number}
- * Pin numbers start at 1 and may go to up to the max number of GPIO pins supported
- * by the SoC.
+ * /dev/pwm-{group number}
+ * Group numbers start at 1 and go up to DEV_FS_PWM_MAX_NUM_GROUPS.  The GPIO's used by
+ * each group are given in its signal definition.
  */
 #define DEV_FS_PWM_DEVICE_TYPE_STRING  "/dev/pwm-"
 
@@ -72,6 +108,7 @@
  * error codes may also be returned.
  */
 #define DEV_FS_PWM_ERROR_SIGNALS_ALREADY_DEFINED -4095
+#define DEV_FS_PWM_ERROR_GPIO_IN_USE -4094 /**< a GPIO in the signal definition is used by another group */
 
 /**
  * @brief
@@ -82,6 +119,13 @@ enum DSPAL_PWM_IOCTLS {
 	PWM_IOCTL_INVALID = -1, /**< invalid IOCTL code, used to return an error */                                 //!< PWM_IOCTL_INVALID
 	PWM_IOCTL_SIGNAL_DEFINITION, /**< used to define the gpio number(s) and period of the pulse width(s) */     //!< PWM_IOCTL_SIGNAL_DEFINITION
 	PWM_IOCTL_GET_UPDATE_BUFFER, /**< returns a buffer used to update the pulse width in real-time */      //!< PWM_IOCTL_GET_PULSE_WIDTH_BUFFER
+	PWM_IOCTL_GET_COMMIT_BUFFER, /**< returns a buffer used to update all pulse widths atomically */      //!< PWM_IOCTL_GET_COMMIT_BUFFER
+	PWM_IOCTL_GET_CAPABILITIES, /**< returns the limits of the PWM signal generator */                          //!< PWM_IOCTL_GET_CAPABILITIES
+	PWM_IOCTL_SET_OUTPUT_MODE, /**< selects PWM or DShot output, before the signal definition */               //!< PWM_IOCTL_SET_OUTPUT_MODE
+	PWM_IOCTL_GET_DSHOT_TELEMETRY, /**< returns the telemetry received from bidirectional DShot ESC's */        //!< PWM_IOCTL_GET_DSHOT_TELEMETRY
+	PWM_IOCTL_TRIGGER, /**< starts the pulses of a triggered output mode */                                     //!< PWM_IOCTL_TRIGGER
+	PWM_IOCTL_SET_PERIOD, /**< changes the period of the signals at the next period boundary */                 //!< PWM_IOCTL_SET_PERIOD
+	PWM_IOCTL_GET_STATS, /**< returns the timing statistics of the signal generator */                          //!< PWM_IOCTL_GET_STATS
 	PWM_IOCTL_MAX_NUM, /**< number of valid IOCTL codes defined for the PWM generator */                        //!< PWM_IOCTL_MAX_NUM
 };
 
@@ -108,7 +152,7 @@ struct dspal_pwm {
  * for each I/O line specified.
  */
 struct dspal_pwm_ioctl_signal_definition {
-	uint32_t period_in_usecs; /**< the period of the pulses generated, can only be changed once after the device is first opened */
+	uint32_t period_in_usecs; /**< the period of the pulses generated, can only be changed afterwards by PWM_IOCTL_SET_PERIOD */
 	uint32_t num_gpios; /**< number of signals specified in the following array */
 	struct dspal_pwm *pwm_signal; /**< array defining the GPIO lines and pulse widths to be used by the signal generator */
 };
@@ -132,7 +176,245 @@ struct dspal_pwm_ioctl_signal_definition {
 struct dspal_pwm_ioctl_update_buffer {
 	uint32_t num_gpios; /**< the number of PWM's specified in the following array */
 	struct dspal_pwm *pwm_signal; /**< array defining the GPIO lines and pulse widths to be used by the signal generator, can only be specified once after the device is first opened */
-	uint32_t reserved_1; /**< reserved value used for debugging. */
-	uint32_t reserved_2; /**< reserved value used for debugging. */
+	uint32_t reserved_1; /**< reserved value used for debugging, @see PWM_IOCTL_GET_STATS for documented counters. */
+	uint32_t reserved_2; /**< reserved value used for debugging, @see PWM_IOCTL_GET_STATS for documented counters. */
+};
+
+/**
+ * @brief
+ * Structure used in the ioctl: PWM_IOCTL_GET_CAPABILITIES
+ *
+ * Returns the limits of the PWM signal generator.  This ioctl may be used before
+ * the signals of the device are defined.
+ */
+struct dspal_pwm_ioctl_capabilities {
+	uint32_t max_num_signals;      /**< maximum number of signals in the signal definition of one group */
+	uint32_t max_num_groups;       /**< maximum number of groups that can be defined at the same time */
+	uint32_t num_groups_in_use;    /**< number of groups currently defined, including this device if defined */
+	uint32_t min_period_in_usecs;  /**< minimum period that can be specified in a signal definition */
+	uint32_t max_period_in_usecs;  /**< maximum period that can be specified in a signal definition */
+	uint32_t resolution_in_nsecs;  /**< resolution of the timer generating the edges of the pulses */
+};
+
+/**
+ * @brief
+ * Structure used in the ioctl: PWM_IOCTL_SET_PERIOD
+ *
+ * Changes the period of all signals of the group.  The current period is completed and the
+ * new period starts at its end, so no pulse is cut short or stretched.  The ioctl fails if the
+ * period is outside the limits returned by PWM_IOCTL_GET_CAPABILITIES, or shorter than the
+ * pulse width of a signal.  In the triggered and DShot output modes the period has the meaning
+ * given in dspal_pwm_ioctl_output_mode.
+ */
+struct dspal_pwm_ioctl_period {
+	uint32_t period_in_usecs;     /**< the new period */
+	uint32_t start_period_count;  /**< returned, the value of period_count in the commit buffer of the first period of the new length */
+};
+
+/**
+ * @brief
+ * Structure used in the ioctl: PWM_IOCTL_GET_STATS
+ *
+ * Returns timing statistics of the signal generator, accumulated since the signal definition
+ * or the last reset.  An edge is the start or the end of a pulse.
+ */
+struct dspal_pwm_ioctl_stats {
+	uint32_t reset;                         /**< input, non-zero to reset the statistics after they are returned */
+	uint32_t periods_generated;             /**< number of periods, frames or triggers generated */
+	uint32_t late_edges;                    /**< number of edges generated later than the resolution of the timer */
+	uint32_t max_edge_jitter_in_nsecs;      /**< largest difference between the programmed and actual time of an edge */
+	uint32_t last_commit_latency_in_nsecs;  /**< time from the last commit to the first edge using it, 0 unless @see dspal_pwm_set_commit_time is used */
+	uint32_t max_commit_latency_in_nsecs;   /**< largest commit latency */
+};
+
+/**
+ * @brief
+ * Output modes used in the ioctl: PWM_IOCTL_SET_OUTPUT_MODE
+ */
+enum DSPAL_PWM_OUTPUT_MODE {
+	DSPAL_PWM_OUTPUT_MODE_PWM = 0,   /**< PWM signals of the specified pulse width, the default */
+	DSPAL_PWM_OUTPUT_MODE_DSHOT150,  /**< DShot frames at 150 kbit/s */
+	DSPAL_PWM_OUTPUT_MODE_DSHOT300,  /**< DShot frames at 300 kbit/s */
+	DSPAL_PWM_OUTPUT_MODE_DSHOT600,  /**< DShot frames at 600 kbit/s */
+	DSPAL_PWM_OUTPUT_MODE_ONESHOT125, /**< triggered pulses of 125 to 250 usecs */
+	DSPAL_PWM_OUTPUT_MODE_ONESHOT42, /**< triggered pulses of 42 to 84 usecs */
+	DSPAL_PWM_OUTPUT_MODE_MULTISHOT, /**< triggered pulses of 5 to 25 usecs */
+};
+
+/**
+ * @brief
+ * Structure used in the ioctl: PWM_IOCTL_SET_OUTPUT_MODE
+ *
+ * Selects the type of signal generated by this device.  The ioctl must be used before the
+ * signal definition and fails with DEV_FS_PWM_ERROR_SIGNALS_ALREADY_DEFINED after it.
+ *
+ * @par
+ * In DShot mode the pulse_width_in_usecs member of each signal in the signal definition is
+ * ignored and DSPAL_DSHOT_CMD_MOTOR_STOP is sent until the first commit.  Each element of
+ * dspal_pwm_commit_buffer.pulse_width_in_nsecs holds the frame returned by
+ * dspal_dshot_encode_frame() instead of a pulse width.  The period of the signal definition
+ * must leave enough time to send a frame and, if bidirectional, to receive the reply.
+ *
+ * @par
+ * In the triggered modes, OneShot and Multishot, pulses only start when PWM_IOCTL_TRIGGER is
+ * used.  The period of the signal definition is then the longest time between pulses: if no
+ * trigger occurs within it, the pulses of the last commit are sent again.  The pulse widths
+ * are written to the buffer returned by PWM_IOCTL_GET_COMMIT_BUFFER, in nsecs.
+ */
+struct dspal_pwm_ioctl_output_mode {
+	uint32_t mode;             /**< one of DSPAL_PWM_OUTPUT_MODE */
+	uint32_t bidirectional;    /**< DShot only, non-zero to invert the signals and receive a telemetry reply after each frame */
+	uint32_t min_gap_in_usecs; /**< triggered modes only, minimum time from the end of the longest pulse to the next trigger, 0 for the pulse width range of the mode */
+};
+
+/**
+ * @brief
+ * Structure used in the ioctl: PWM_IOCTL_TRIGGER
+ *
+ * Applies the last commit to the buffer returned by PWM_IOCTL_GET_COMMIT_BUFFER and starts
+ * the pulses of all signals at once.  If the previous pulses, followed by the minimum gap of
+ * the output mode, have not ended, the pulses are started as soon as they have.  The pulses
+ * of a trigger are never dropped, but a trigger replaces a deferred trigger.
+ *
+ * @par
+ * The argument of the ioctl may be NULL if the delay is not needed.
+ */
+struct dspal_pwm_ioctl_trigger {
+	uint32_t delay_in_nsecs; /**< returned, time until the pulses start, 0 unless deferred by the minimum gap */
 };
 
+/**
+ * @brief
+ * Structure used in the ioctl: PWM_IOCTL_GET_DSHOT_TELEMETRY
+ *
+ * Returns the latest telemetry reply received on each signal of a bidirectional DShot group.
+ */
+struct dspal_pwm_ioctl_dshot_telemetry {
+	uint32_t num_gpios;        /**< the number of signals, in the order specified in the signal definition */
+	uint32_t valid_mask;       /**< bit i is set if signal i received a valid reply to the last frame */
+	uint32_t num_reply_errors; /**< number of replies missing or rejected by dspal_dshot_decode_telemetry() since the signal definition */
+	uint32_t erpm_period_in_usecs[DEV_FS_PWM_MAX_NUM_SIGNALS]; /**< latest valid reply of each signal, @see dspal_dshot_erpm */
+};
+
+/**
+ * @brief
+ * Bit fields of dspal_pwm_commit_buffer.commit_state
+ */
+#define DSPAL_PWM_COMMIT_INDEX_MASK   0x3 /**< index of the ready buffer in pulse_width_in_nsecs */
+#define DSPAL_PWM_COMMIT_PENDING      0x4 /**< set if the ready buffer has not been taken by the signal generator */
+#define DSPAL_PWM_COMMIT_SEQ_SHIFT    3   /**< the remaining bits contain the sequence number of the ready buffer */
+
+/**
+ * @brief
+ * Structure returned by the ioctl: PWM_IOCTL_GET_COMMIT_BUFFER
+ *
+ * Returns a buffer used to change the width of all pulses at once.  Unlike the buffer returned
+ * by PWM_IOCTL_GET_UPDATE_BUFFER, which is read by the signal generator while it is being
+ * modified, new pulse widths written to this buffer take effect together at the start of the
+ * next period after they are committed.
+ *
+ * @par
+ * The buffer holds three sets of pulse widths.  One is used by the signal generator, one is
+ * ready to be used at the next period boundary and one, the back buffer, is modified by the
+ * caller.  dspal_pwm_commit() exchanges the back buffer with the ready buffer, and at the start
+ * of each period the signal generator exchanges the buffer in use with the ready buffer if a
+ * commit is pending.  Neither side ever waits for the other.  If several commits are made
+ * within one period, only the last one is used.
+ *
+ * @par
+ * When the ioctl returns, all three sets contain the pulse widths of the signal definition.
+ * At the start of each period, if DSPAL_PWM_COMMIT_PENDING is set in commit_state, the signal
+ * generator atomically replaces commit_state with the index of the set it was using, switches
+ * to the ready set and then updates applied_state.
+ *
+ * @par
+ * The back buffer returned by dspal_pwm_get_back_buffer() is recycled, so the pulse width
+ * of every signal must be written before each commit.  The buffer must only be used by one
+ * thread at a time.  Apart from the back buffer, no structure member may be modified except
+ * through the functions below.
+ */
+struct dspal_pwm_commit_buffer {
+	uint32_t num_gpios;               /**< the number of PWM's, in the order specified in the signal definition */
+	uint32_t back_index;              /**< index of the back buffer, @see dspal_pwm_get_back_buffer */
+	uint32_t last_commit_seq;         /**< sequence number returned by the last call to dspal_pwm_commit() */
+	volatile uint32_t commit_state;   /**< ready buffer index, pending flag and sequence number */
+	volatile uint64_t applied_state;  /**< read-only, period count (upper 32 bits) in which the sequence number in the lower 32 bits took effect */
+	volatile uint32_t period_count;   /**< read-only, number of periods generated since the signal definition */
+	uint32_t pulse_width_in_nsecs[3][DEV_FS_PWM_MAX_NUM_SIGNALS]; /**< pulse width of each signal, in nsecs, or DShot frame */
+	uint64_t commit_time_in_nsecs[3]; /**< optional CLOCK_MONOTONIC time of the commit of each set, @see dspal_pwm_set_commit_time */
+};
+
+/**
+ * @brief
+ * Returns the array used to set the pulse width of each signal, in nsecs, before the next call
+ * to dspal_pwm_commit().
+ */
+static inline uint32_t *dspal_pwm_get_back_buffer(struct dspal_pwm_commit_buffer *buffer)
+{
+	return buffer->pulse_width_in_nsecs[buffer->back_index];
+}
+
+/**
+ * @brief
+ * Records the time of the next commit, used by the signal generator to measure the commit
+ * latency returned by PWM_IOCTL_GET_STATS.  If used, it must be called before each call to
+ * dspal_pwm_commit(), otherwise the latency is not measured.  The signal generator clears the
+ * time of each set of pulse widths once it has been measured.
+ *
+ * @param buffer the buffer returned by PWM_IOCTL_GET_COMMIT_BUFFER
+ * @param time_in_nsecs the CLOCK_MONOTONIC time, in nsecs
+ */
+static inline void dspal_pwm_set_commit_time(struct dspal_pwm_commit_buffer *buffer, uint64_t time_in_nsecs)
+{
+	buffer->commit_time_in_nsecs[buffer->back_index] = time_in_nsecs;
+}
+
+/**
+ * @brief
+ * Makes the pulse widths written to the back buffer available to the signal generator,
+ * to take effect at the start of the next period.
+ *
+ * @return
+ * The sequence number of this commit, to be passed to dspal_pwm_get_commit_period().
+ */
+static inline uint32_t dspal_pwm_commit(struct dspal_pwm_commit_buffer *buffer)
+{
+	uint32_t seq = buffer->last_commit_seq + 1;
+	uint32_t state = (seq << DSPAL_PWM_COMMIT_SEQ_SHIFT) | DSPAL_PWM_COMMIT_PENDING | buffer->back_index;
+
+	/* The release ordering publishes the back buffer contents along with the commit. */
+	state = __atomic_exchange_n(&buffer->commit_state, state, __ATOMIC_ACQ_REL);
+	buffer->back_index = state & DSPAL_PWM_COMMIT_INDEX_MASK;
+	buffer->last_commit_seq = seq;
+
+	return seq;
+}
+
+/**
+ * @brief
+ * Checks if the commit identified by seq has taken effect.
+ *
+ * @param buffer the buffer returned by PWM_IOCTL_GET_COMMIT_BUFFER
+ * @param seq the sequence number returned by dspal_pwm_commit()
+ * @param period on success, the value of period_count in which the commit took effect.  If the
+ * commit was replaced by a later commit within the same period, the period in which the later
+ * commit took effect is returned.
+ *
+ * @return
+ * - 1 if the commit has taken effect
+ * - 0 if the commit is still pending
+ */
+static inline int dspal_pwm_get_commit_period(const struct dspal_pwm_commit_buffer *buffer, uint32_t seq,
+		uint32_t *period)
+{
+	uint64_t applied = __atomic_load_n(&buffer->applied_state, __ATOMIC_ACQUIRE);
+	uint32_t applied_seq = (uint32_t)applied;
+
+	/* Sequence numbers wrap within the bits available in commit_state. */
+	if ((int32_t)((applied_seq - seq) << DSPAL_PWM_COMMIT_SEQ_SHIFT) < 0) {
+		return 0;
+	}
+
+	*period = (uint32_t)(applied >> 32);
+	return 1;
+}
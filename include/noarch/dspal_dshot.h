@@ -0,0 +1,276 @@
+/****************************************************************************
+ * Copyright (c) 2026 ATLFlight. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name ATLFlight nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Encoder and decoder of the DShot digital ESC protocol.  These functions are used by
+ * the PWM signal generator in DShot mode (@see PWM_IOCTL_SET_OUTPUT_MODE), and do not
+ * depend on the aDSP, so they can also be used and tested on the application processor.
+ *
+ * @par
+ * A DShot frame is 16 bits, sent MSB first: an 11 bit throttle value, a telemetry request
+ * bit and a 4 bit CRC.  Each bit starts with a rising edge and the width of the pulse gives
+ * its value.  Throttle values 1 to 47 are reserved for commands and 0 stops the motor.
+ *
+ * @par
+ * With bidirectional DShot the signal is inverted, the CRC is inverted and, after each frame,
+ * the ESC replies on the same line with the period of one electrical revolution.  The reply
+ * is 21 bits at 5/4 of the bit rate of the frame, GCR encoded.
+ */
+
+#define DSPAL_DSHOT_FRAME_BITS 16 /**< number of bits in a frame sent to the ESC */
+#define DSPAL_DSHOT_TELEMETRY_BITS 21 /**< number of bits in the reply of a bidirectional ESC, including the start bit */
+#define DSPAL_DSHOT_MIN_THROTTLE 48 /**< smallest throttle value, smaller values are commands */
+#define DSPAL_DSHOT_MAX_THROTTLE 2047 /**< largest throttle value */
+#define DSPAL_DSHOT_CMD_MOTOR_STOP 0 /**< throttle value of a disarmed motor */
+#define DSPAL_DSHOT_ERPM_PERIOD_STOPPED 65408 /**< largest period that can be reported, sent when the motor is stopped */
+
+/**
+ * @brief
+ * Timing of one DShot bit, in nsecs.  A one is sent as a pulse of 3/4 of the bit period
+ * and a zero as a pulse of 3/8 of the bit period.
+ */
+struct dspal_dshot_timing {
+	uint32_t bit_period_in_nsecs; /**< duration of one bit */
+	uint32_t t0h_in_nsecs;        /**< width of the pulse of a zero */
+	uint32_t t1h_in_nsecs;        /**< width of the pulse of a one */
+};
+
+/**
+ * @brief
+ * The frames of all signals of a group, in the form used to send them in a single pass.
+ * For each bit, all signals are set at the start of the bit, the signals sending a zero are
+ * cleared after t0h_in_nsecs and the remaining signals after t1h_in_nsecs.  Bit i of a mask
+ * refers to the signal at index i of the signal definition.
+ */
+struct dspal_dshot_batch {
+	uint32_t signal_mask;                            /**< the signals set at the start of each bit */
+	uint32_t zero_mask[DSPAL_DSHOT_FRAME_BITS];      /**< for each bit, MSB first, the signals sending a zero */
+};
+
+/**
+ * @brief
+ * Returns the timing of a bit at a bit rate of 150, 300 or 600 kbit/s.
+ */
+static inline void dspal_dshot_get_timing(uint32_t bit_rate_in_kbps, struct dspal_dshot_timing *timing)
+{
+	timing->bit_period_in_nsecs = 1000000 / bit_rate_in_kbps;
+	timing->t0h_in_nsecs = timing->bit_period_in_nsecs * 3 / 8;
+	timing->t1h_in_nsecs = timing->bit_period_in_nsecs * 3 / 4;
+}
+
+/**
+ * @brief
+ * Returns the CRC of the 12 bits of throttle and telemetry request of a frame.
+ */
+static inline uint32_t dspal_dshot_crc(uint32_t value, int bidirectional)
+{
+	uint32_t crc = value ^ (value >> 4) ^ (value >> 8);
+
+	if (bidirectional) { crc = ~crc; }
+
+	return crc & 0xF;
+}
+
+/**
+ * @brief
+ * Encodes a frame.
+ *
+ * @param throttle throttle value or command, up to DSPAL_DSHOT_MAX_THROTTLE
+ * @param telemetry non-zero to request telemetry from the ESC
+ * @param bidirectional non-zero if the ESC uses bidirectional DShot
+ *
+ * @return
+ * The 16 bit frame.
+ */
+static inline uint32_t dspal_dshot_encode_frame(uint32_t throttle, int telemetry, int bidirectional)
+{
+	uint32_t value = ((throttle & DSPAL_DSHOT_MAX_THROTTLE) << 1) | (telemetry ? 1 : 0);
+
+	return (value << 4) | dspal_dshot_crc(value, bidirectional);
+}
+
+/**
+ * @brief
+ * Decodes a frame, as done by the ESC.
+ *
+ * @return
+ * - 0 on success
+ * - -1 if the CRC does not match
+ */
+static inline int dspal_dshot_decode_frame(uint32_t frame, int bidirectional, uint32_t *throttle, int *telemetry)
+{
+	uint32_t value = (frame >> 4) & 0xFFF;
+
+	if ((frame & 0xF) != dspal_dshot_crc(value, bidirectional)) {
+		return -1;
+	}
+
+	*throttle = value >> 1;
+	*telemetry = value & 1;
+	return 0;
+}
+
+/**
+ * @brief
+ * Converts the frames of num_signals signals, in the order of the signal definition, to
+ * the masks used to send them together.
+ */
+static inline void dspal_dshot_encode_batch(const uint32_t *frames, uint32_t num_signals,
+		struct dspal_dshot_batch *batch)
+{
+	uint32_t bit, signal;
+
+	batch->signal_mask = (num_signals >= 32) ? 0xFFFFFFFF : (1u << num_signals) - 1;
+
+	for (bit = 0; bit < DSPAL_DSHOT_FRAME_BITS; bit++) {
+		uint32_t frame_bit = 1u << (DSPAL_DSHOT_FRAME_BITS - 1 - bit);
+
+		batch->zero_mask[bit] = 0;
+
+		for (signal = 0; signal < num_signals; signal++) {
+			if (!(frames[signal] & frame_bit)) { batch->zero_mask[bit] |= 1u << signal; }
+		}
+	}
+}
+
+/**
+ * @brief
+ * Returns the 5 bit GCR code of a nibble of a telemetry reply.
+ */
+static inline uint32_t dspal_dshot_gcr_encode_nibble(uint32_t nibble)
+{
+	static const uint8_t gcr[16] = {
+		0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17,
+		0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F
+	};
+
+	return gcr[nibble & 0xF];
+}
+
+/**
+ * @brief
+ * Encodes a telemetry reply, as done by the ESC.
+ *
+ * @param period_in_usecs period of one electrical revolution.  Values larger than
+ * DSPAL_DSHOT_ERPM_PERIOD_STOPPED are sent as DSPAL_DSHOT_ERPM_PERIOD_STOPPED, and the
+ * resolution decreases for periods longer than 511 usecs.
+ *
+ * @return
+ * The DSPAL_DSHOT_TELEMETRY_BITS line levels of the reply, MSB first, with the start bit
+ * read as 1.
+ */
+static inline uint32_t dspal_dshot_encode_telemetry(uint32_t period_in_usecs)
+{
+	uint32_t exponent = 0;
+	uint32_t value, gcr = 0, levels = 1;
+	int bit;
+
+	if (period_in_usecs > DSPAL_DSHOT_ERPM_PERIOD_STOPPED) { period_in_usecs = DSPAL_DSHOT_ERPM_PERIOD_STOPPED; }
+
+	while ((period_in_usecs >> exponent) > 0x1FF) { exponent++; }
+
+	value = (exponent << 9) | (period_in_usecs >> exponent);
+	value = (value << 4) | (~(value ^ (value >> 4) ^ (value >> 8)) & 0xF);
+
+	for (bit = 12; bit >= 0; bit -= 4) {
+		gcr = (gcr << 5) | dspal_dshot_gcr_encode_nibble(value >> bit);
+	}
+
+	/* Each 1 in the GCR code is sent as a change of the line level. */
+	for (bit = 19; bit >= 0; bit--) {
+		levels = (levels << 1) | ((levels ^ (gcr >> bit)) & 1);
+	}
+
+	return levels;
+}
+
+/**
+ * @brief
+ * Decodes a telemetry reply.
+ *
+ * @param levels the DSPAL_DSHOT_TELEMETRY_BITS line levels of the reply, MSB first, with
+ * the start bit read as 1
+ * @param period_in_usecs on success, the period of one electrical revolution
+ *
+ * @return
+ * - 0 on success
+ * - -1 if the reply contains an invalid GCR code or the CRC does not match
+ */
+static inline int dspal_dshot_decode_telemetry(uint32_t levels, uint32_t *period_in_usecs)
+{
+	uint32_t gcr = (levels ^ (levels >> 1)) & 0xFFFFF;
+	uint32_t value = 0, crc;
+	int bit;
+
+	for (bit = 15; bit >= 0; bit -= 5) {
+		uint32_t code = (gcr >> bit) & 0x1F;
+		uint32_t nibble = 0;
+
+		while (nibble < 16 && dspal_dshot_gcr_encode_nibble(nibble) != code) { nibble++; }
+
+		if (nibble == 16) {
+			return -1;
+		}
+
+		value = (value << 4) | nibble;
+	}
+
+	crc = value ^ (value >> 8);
+	crc ^= crc >> 4;
+
+	if ((crc & 0xF) != 0xF) {
+		return -1;
+	}
+
+	*period_in_usecs = ((value >> 4) & 0x1FF) << (value >> 13);
+	return 0;
+}
+
+/**
+ * @brief
+ * Returns the electrical RPM for the period of a telemetry reply, or 0 if the motor is
+ * stopped.  The mechanical RPM is the electrical RPM divided by the number of pole pairs
+ * of the motor.
+ */
+static inline uint32_t dspal_dshot_erpm(uint32_t period_in_usecs)
+{
+	if (period_in_usecs == 0 || period_in_usecs >= DSPAL_DSHOT_ERPM_PERIOD_STOPPED) {
+		return 0;
+	}
+
+	return 60000000 / period_in_usecs;
+}
@@ -0,0 +1,304 @@
+/****************************************************************************
+ * Copyright (c) 2026 ATLFlight. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name ATLFlight nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file
+ * Hierarchical timing wheel used to keep the POSIX timers of dspal_time.h.  Arming and
+ * disarming a timer take constant time, whatever the number of timers armed, and a single
+ * hardware timer is programmed for the tick returned by dspal_timer_wheel_next_tick().
+ * These functions do not depend on the aDSP and can also be used on the application
+ * processor.
+ *
+ * @par
+ * Level 0 of the wheel has one slot per tick for the next DSPAL_TIMER_WHEEL_SLOTS ticks, and
+ * each slot of the following levels covers DSPAL_TIMER_WHEEL_SLOTS slots of the previous level.
+ * When the current tick reaches the start of a slot of level 1 or above, its timers are moved
+ * to the lower levels.  Timers beyond the range of the last level are kept in its first slot
+ * and placed again when the last level wraps around.
+ *
+ * @par
+ * The wheel does not allocate memory: each timer embeds a struct dspal_timer_wheel_entry.
+ * The functions are not thread safe, the caller must serialize access to a wheel.
+ */
+
+#define DSPAL_TIMER_WHEEL_SLOT_BITS 6 /**< log2 of the number of slots of each level */
+#define DSPAL_TIMER_WHEEL_SLOTS (1 << DSPAL_TIMER_WHEEL_SLOT_BITS) /**< number of slots of each level */
+#define DSPAL_TIMER_WHEEL_LEVELS 4 /**< number of levels, the wheel covers 2^24 ticks */
+
+/**
+ * @brief
+ * Timer kept by the wheel.  The members are private to the wheel, except expiry which may be
+ * read.  An entry must be initialized by dspal_timer_wheel_entry_init() before its first use.
+ */
+struct dspal_timer_wheel_entry {
+	struct dspal_timer_wheel_entry *next;
+	struct dspal_timer_wheel_entry *prev;
+	uint64_t expiry;  /**< tick at which the timer expires */
+	uint8_t level;
+	uint8_t slot;
+};
+
+/**
+ * @brief
+ * State of a wheel.  Each slot is the head of a circular list of entries.
+ */
+struct dspal_timer_wheel {
+	uint64_t now;                                          /**< current tick */
+	uint64_t occupied[DSPAL_TIMER_WHEEL_LEVELS];           /**< bit i is set if slot i of the level is not empty */
+	struct dspal_timer_wheel_entry slots[DSPAL_TIMER_WHEEL_LEVELS][DSPAL_TIMER_WHEEL_SLOTS];
+	uint32_t num_entries;                                  /**< number of armed timers */
+};
+
+static inline void dspal_timer_wheel_entry_init(struct dspal_timer_wheel_entry *entry)
+{
+	entry->next = NULL;
+	entry->prev = NULL;
+}
+
+/**
+ * @brief
+ * Returns non-zero if the entry is armed in a wheel.
+ */
+static inline int dspal_timer_wheel_is_armed(const struct dspal_timer_wheel_entry *entry)
+{
+	return entry->next != NULL;
+}
+
+/**
+ * @brief
+ * Initializes an empty wheel with its current tick.
+ */
+static inline void dspal_timer_wheel_init(struct dspal_timer_wheel *wheel, uint64_t now)
+{
+	int level, slot;
+
+	wheel->now = now;
+	wheel->num_entries = 0;
+
+	for (level = 0; level < DSPAL_TIMER_WHEEL_LEVELS; level++) {
+		wheel->occupied[level] = 0;
+
+		for (slot = 0; slot < DSPAL_TIMER_WHEEL_SLOTS; slot++) {
+			wheel->slots[level][slot].next = &wheel->slots[level][slot];
+			wheel->slots[level][slot].prev = &wheel->slots[level][slot];
+		}
+	}
+}
+
+/**
+ * @brief
+ * Places an entry in the slot covering its expiry, relative to the current tick.
+ */
+static inline void dspal_timer_wheel_place(struct dspal_timer_wheel *wheel, struct dspal_timer_wheel_entry *entry)
+{
+	uint64_t diff = entry->expiry ^ wheel->now;
+	struct dspal_timer_wheel_entry *head;
+	uint32_t level = 0, slot;
+
+	/* The level is given by the most significant group of bits that differs from now. */
+	while (level < DSPAL_TIMER_WHEEL_LEVELS - 1 && (diff >> ((level + 1) * DSPAL_TIMER_WHEEL_SLOT_BITS)) != 0) {
+		level++;
+	}
+
+	if ((diff >> ((level + 1) * DSPAL_TIMER_WHEEL_SLOT_BITS)) != 0) {
+		/* Beyond the range of the wheel, wait for the start of the next turn of the last level. */
+		slot = 0;
+
+	} else {
+		slot = (uint32_t)(entry->expiry >> (level * DSPAL_TIMER_WHEEL_SLOT_BITS)) & (DSPAL_TIMER_WHEEL_SLOTS - 1);
+	}
+
+	head = &wheel->slots[level][slot];
+	entry->level = level;
+	entry->slot = slot;
+	entry->next = head;
+	entry->prev = head->prev;
+	head->prev->next = entry;
+	head->prev = entry;
+	wheel->occupied[level] |= 1ULL << slot;
+}
+
+/**
+ * @brief
+ * Removes an entry from its slot, without changing the number of armed timers.
+ */
+static inline void dspal_timer_wheel_unlink(struct dspal_timer_wheel *wheel, struct dspal_timer_wheel_entry *entry)
+{
+	struct dspal_timer_wheel_entry *head = &wheel->slots[entry->level][entry->slot];
+
+	entry->prev->next = entry->next;
+	entry->next->prev = entry->prev;
+	entry->next = NULL;
+	entry->prev = NULL;
+
+	if (head->next == head) {
+		wheel->occupied[entry->level] &= ~(1ULL << entry->slot);
+	}
+}
+
+/**
+ * @brief
+ * Arms a timer.  An expiry at or before the current tick is returned by the next call to
+ * dspal_timer_wheel_expire().
+ *
+ * @param entry a timer that is not armed
+ * @param expiry the tick at which the timer expires
+ */
+static inline void dspal_timer_wheel_add(struct dspal_timer_wheel *wheel, struct dspal_timer_wheel_entry *entry,
+		uint64_t expiry)
+{
+	entry->expiry = (expiry < wheel->now) ? wheel->now : expiry;
+	dspal_timer_wheel_place(wheel, entry);
+	wheel->num_entries++;
+}
+
+/**
+ * @brief
+ * Disarms a timer.  Nothing is done if the timer is not armed.
+ */
+static inline void dspal_timer_wheel_remove(struct dspal_timer_wheel *wheel, struct dspal_timer_wheel_entry *entry)
+{
+	if (dspal_timer_wheel_is_armed(entry)) {
+		dspal_timer_wheel_unlink(wheel, entry);
+		wheel->num_entries--;
+	}
+}
+
+/**
+ * @brief
+ * Returns the next tick at which the wheel has work to do: a timer expiring, or timers to be
+ * moved to a lower level.  This is the tick for which the hardware timer is programmed.
+ *
+ * @return
+ * - 1 if the tick is returned
+ * - 0 if no timer is armed
+ */
+static inline int dspal_timer_wheel_next_tick(const struct dspal_timer_wheel *wheel, uint64_t *tick)
+{
+	uint32_t level;
+
+	/* Timers of a level always expire, or move, before those of the following levels. */
+	for (level = 0; level < DSPAL_TIMER_WHEEL_LEVELS; level++) {
+		uint32_t shift = level * DSPAL_TIMER_WHEEL_SLOT_BITS;
+		uint64_t index = wheel->now >> shift;
+		uint64_t occupied = wheel->occupied[level];
+		uint32_t start = (uint32_t)index & (DSPAL_TIMER_WHEEL_SLOTS - 1);
+
+		if (occupied == 0) { continue; }
+
+		if (level == 0 && (occupied & (1ULL << start))) {
+			*tick = wheel->now;
+			return 1;
+		}
+
+		/* Search the slots in the order they are reached, starting after the current slot. */
+		start = (start + 1) & (DSPAL_TIMER_WHEEL_SLOTS - 1);
+		occupied = (occupied >> start) | (occupied << ((DSPAL_TIMER_WHEEL_SLOTS - start) & (DSPAL_TIMER_WHEEL_SLOTS - 1)));
+		*tick = (index + 1 + __builtin_ctzll(occupied)) << shift;
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief
+ * Moves the timers of the slots starting at the current tick to the lower levels.
+ */
+static inline void dspal_timer_wheel_cascade(struct dspal_timer_wheel *wheel)
+{
+	int level;
+
+	for (level = DSPAL_TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+		uint32_t shift = level * DSPAL_TIMER_WHEEL_SLOT_BITS;
+		uint32_t slot = (uint32_t)(wheel->now >> shift) & (DSPAL_TIMER_WHEEL_SLOTS - 1);
+		struct dspal_timer_wheel_entry *head = &wheel->slots[level][slot];
+		struct dspal_timer_wheel_entry *entry, *next;
+
+		if ((wheel->now & ((1ULL << shift) - 1)) != 0 || head->next == head) { continue; }
+
+		/* Detach the list first, since timers beyond the range of the wheel return to this slot. */
+		entry = head->next;
+		head->prev->next = NULL;
+		head->next = head;
+		head->prev = head;
+		wheel->occupied[level] &= ~(1ULL << slot);
+
+		for (; entry != NULL; entry = next) {
+			next = entry->next;
+			dspal_timer_wheel_place(wheel, entry);
+		}
+	}
+}
+
+/**
+ * @brief
+ * Advances the current tick up to now and returns one expired timer at a time.  The timer
+ * returned is disarmed, and may be armed again before the next call, e.g. for a periodic
+ * timer.  Timers are returned in order of expiry, except timers with the same expiry.
+ *
+ * @param now the current tick, the wheel is advanced up to it
+ *
+ * @return
+ * An expired timer, or NULL once no armed timer expires at or before now.
+ */
+static inline struct dspal_timer_wheel_entry *dspal_timer_wheel_expire(struct dspal_timer_wheel *wheel, uint64_t now)
+{
+	uint64_t tick;
+
+	for (;;) {
+		struct dspal_timer_wheel_entry *head = &wheel->slots[0][wheel->now & (DSPAL_TIMER_WHEEL_SLOTS - 1)];
+
+		if (head->next != head) {
+			struct dspal_timer_wheel_entry *entry = head->next;
+
+			dspal_timer_wheel_unlink(wheel, entry);
+			wheel->num_entries--;
+			return entry;
+		}
+
+		/* Skip the ticks at which there is nothing to do. */
+		if (!dspal_timer_wheel_next_tick(wheel, &tick) || tick > now) {
+			if (now > wheel->now) { wheel->now = now; }
+
+			return NULL;
+		}
+
+		wheel->now = tick;
+		dspal_timer_wheel_cascade(wheel);
+	}
+}
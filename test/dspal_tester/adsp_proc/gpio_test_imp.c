@@ -445,3 +445,131 @@ exit:
 #endif
 	return result;
 }
+
+#define GPIO_FAST_HANDLE_TIMING_LOOPS 10000
+
+/**
+* @brief Test the fast GPIO handle used to access the I/O line without read() and write()
+*
+* @par Tests:
+* This test verifies that a handle can only be obtained for a GPIO device configured
+* in general purpose I/O mode, that the dspal_gpio_fast_*() functions drive the I/O
+* line, and reports the time per call compared to write().
+* Test:
+* 1) Opens file for GPIO device  (gpio-10)
+* 2) Requests a fast handle before the device is configured and checks that this fails
+* 3) Uses ioctl to set the GPIO pin to be in IO mode and requests the fast handle
+* 4) Sets, clears and toggles the output with the fast handle, and checks the value
+*    with both dspal_gpio_fast_read() and read()
+* 5) Measures the average time of GPIO_FAST_HANDLE_TIMING_LOOPS toggles using the
+*    fast handle and using write()
+*
+* @return
+* TEST_PASS ------ Test Passes
+* TEST_FAIL ------ Test Failed
+* TEST_SKIP ------ Test Skipped, the DSPAL version does not support fast handles
+*/
+int dspal_tester_test_gpio_fast_handle(void)
+{
+	int result = TEST_PASS;
+	int fd;
+	enum DSPAL_GPIO_VALUE_TYPE value_written = DSPAL_GPIO_LOW_VALUE;
+	enum DSPAL_GPIO_VALUE_TYPE value_read;
+	struct dspal_gpio_fast_handle handle;
+	struct timespec start, finish;
+	long long fast_elapsed_ns, write_elapsed_ns;
+	struct dspal_gpio_ioctl_config_io config = {
+		.direction = DSPAL_GPIO_DIRECTION_OUTPUT,
+		.pull = DSPAL_GPIO_NO_PULL,
+		.drive = DSPAL_GPIO_2MA,
+	};
+
+	if (!dspal_tester_is_version_supported(1, 4)) {
+		return TEST_SKIP;
+	}
+
+	// Open GPIO device
+	fd = open(GPIO_DEVICE_PATH, 0);
+
+	if (fd == -1) {
+		LOG_ERR("open gpio device failed.");
+		result = TEST_FAIL;
+		goto exit;
+	}
+
+	// The handle must be rejected until the device is in general purpose I/O mode
+	if (ioctl(fd, DSPAL_GPIO_IOCTL_GET_FAST_HANDLE, (void *)&handle) == SUCCESS) {
+		LOG_ERR("error: fast handle returned for an unconfigured gpio device");
+		result = TEST_FAIL;
+		goto exit;
+	}
+
+	// Configure GPIO device into general purpose I/O mode
+	if (ioctl(fd, DSPAL_GPIO_IOCTL_CONFIG_IO, (void *)&config) != SUCCESS) {
+		LOG_ERR("ioctl gpio device failed");
+		result = TEST_FAIL;
+		goto exit;
+	}
+
+	if (ioctl(fd, DSPAL_GPIO_IOCTL_GET_FAST_HANDLE, (void *)&handle) != SUCCESS ||
+	    handle.in_out_reg == NULL || handle.out_mask == 0) {
+		LOG_ERR("error: ioctl DSPAL_GPIO_IOCTL_GET_FAST_HANDLE failed");
+		result = TEST_FAIL;
+		goto exit;
+	}
+
+	// Drive the output with the fast handle and verify through both access paths
+	for (int i = 0; i < 100; i++) {
+		if (i % 3 == 0) {
+			dspal_gpio_fast_set(&handle);
+			value_written = DSPAL_GPIO_HIGH_VALUE;
+
+		} else if (i % 3 == 1) {
+			dspal_gpio_fast_clear(&handle);
+			value_written = DSPAL_GPIO_LOW_VALUE;
+
+		} else {
+			dspal_gpio_fast_toggle(&handle);
+			value_written = value_written ^ 0x01;
+		}
+
+		if (dspal_gpio_fast_read(&handle) != value_written) {
+			LOG_ERR("error: dspal_gpio_fast_read inconsistent value");
+			result = TEST_FAIL;
+			goto exit;
+		}
+
+		if (read(fd, &value_read, 1) != 1 || value_read != value_written) {
+			LOG_ERR("error: read inconsistent value");
+			result = TEST_FAIL;
+			goto exit;
+		}
+	}
+
+	// Compare the cost of toggling the output through each access path
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int i = 0; i < GPIO_FAST_HANDLE_TIMING_LOOPS; i++) {
+		dspal_gpio_fast_toggle(&handle);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	fast_elapsed_ns = (finish.tv_sec - start.tv_sec) * 1000000000LL + (finish.tv_nsec - start.tv_nsec);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (int i = 0; i < GPIO_FAST_HANDLE_TIMING_LOOPS; i++) {
+		value_written = value_written ^ 0x01;
+		write(fd, &value_written, 1);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	write_elapsed_ns = (finish.tv_sec - start.tv_sec) * 1000000000LL + (finish.tv_nsec - start.tv_nsec);
+
+	LOG_INFO("gpio toggle: fast handle %lld ns/call, write() %lld ns/call",
+		 fast_elapsed_ns / GPIO_FAST_HANDLE_TIMING_LOOPS, write_elapsed_ns / GPIO_FAST_HANDLE_TIMING_LOOPS);
+
+exit:
+	close(fd);
+	return result;
+}
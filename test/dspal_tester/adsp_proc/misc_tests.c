@@ -30,6 +30,8 @@
  *
  ****************************************************************************/
 
+#include <stdlib.h>
+#include <string.h>
 #include <dspal_version.h>
 #include "test_utils.h"
 #include "dspal_tester.h"
@@ -47,3 +49,45 @@ int dspal_tester_test_dspal_get_version_info()
 
 	return 0;
 }
+
+/**
+ * @brief Checks if the DSPAL implementation in the DSP image is recent enough
+ * to support the feature under test.
+ *
+ * @param   required_major[in]   minimum major version number
+ * @param   required_minor[in]   minimum minor version number, for the given major version
+ *
+ * @return
+ * TRUE ------ The DSPAL version is equal or above the version specified
+ * FALSE ----- The DSPAL version is below the version specified, or cannot be parsed
+*/
+int dspal_tester_is_version_supported(int required_major, int required_minor)
+{
+	struct dspal_version_info version;
+	char *major_string, *minor_string;
+	int major_version, minor_version;
+
+	dspal_get_version_info_ext(&version);
+
+	// DSPAL_VERSION_STRING=DSPAL-{major}.{minor}.{update}.{build_number}
+	strtok(version.version_string, "-.");
+	major_string = strtok(NULL, "-.");
+	minor_string = strtok(NULL, "-.");
+
+	if (major_string == NULL || minor_string == NULL) {
+		LOG_ERR("unable to parse the DSPAL version string");
+		return FALSE;
+	}
+
+	major_version = atoi(major_string);
+	minor_version = atoi(minor_string);
+
+	if (major_version < required_major ||
+	    (major_version == required_major && minor_version < required_minor)) {
+		LOG_INFO("current DSPAL version: %d.%d, requires version %d.%d or above",
+			 major_version, minor_version, required_major, required_minor);
+		return FALSE;
+	}
+
+	return TRUE;
+}
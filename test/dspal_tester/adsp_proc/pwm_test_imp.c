@@ -42,6 +42,63 @@
 #include "test_status.h"
 #include "test_utils.h"
 
+#define PWM_TEST_PULSE_WIDTH_INCREMENTS 10
+#define PWM_TEST_MINIMUM_PULSE_WIDTH 1050
+#define PWM_TEST_PERIOD_IN_USECS 2000
+#define PWM_TEST_NUM_GPIOS 4
+#define PWM_TEST_SERVO_PERIOD_IN_USECS 20000
+#define PWM_TEST_SERVO_PULSE_WIDTH 1500
+#define PWM_TEST_SERVO_NUM_GPIOS 2
+#define PWM_TEST_SERVO_FIRST_GPIO 49
+#define PWM_TEST_DSHOT_PERIOD_IN_USECS 250
+#define PWM_TEST_DSHOT_NUM_UPDATES 4000
+#define PWM_TEST_ONESHOT125_MIN_PULSE_WIDTH_IN_NSECS 125000
+#define PWM_TEST_ONESHOT_NUM_TRIGGERS 1000
+#define PWM_TEST_NEW_PERIOD_IN_USECS 2500
+#define PWM_TEST_NUM_PERIOD_CHANGES 20
+#define INCREMENT_PULSE_WIDTH(x,y) ((x + PWM_TEST_PULSE_WIDTH_INCREMENTS) >= y ? PWM_TEST_MINIMUM_PULSE_WIDTH : x + PWM_TEST_PULSE_WIDTH_INCREMENTS)
+
+/**
+* @brief
+* Defines the PWM signals used by the tests below, on GPIO 45, 46, 47 and 48.
+*
+* @param fd[in] file descriptor of the open PWM device
+* @param period_in_usecs[in] period of the signals
+* @param pwm_gpio[out] array of PWM_TEST_NUM_GPIOS signals to be referenced by the signal definition
+* @param signal_definition[out] the signal definition sent to the DSP
+*
+* @return
+* SUCCESS ------ Signals defined
+* ERROR ------ The signal definition was rejected
+*/
+static int pwm_test_define_signals(int fd, uint32_t period_in_usecs, struct dspal_pwm *pwm_gpio,
+				   struct dspal_pwm_ioctl_signal_definition *signal_definition)
+{
+	// Define the initial pulse width and number of the GPIO to
+	// use for this signal definition.
+	// 45,46,47,48
+	pwm_gpio[0].gpio_id = 45;
+	pwm_gpio[0].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH;
+	pwm_gpio[1].gpio_id = 46;
+	pwm_gpio[1].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH + 10;
+	pwm_gpio[2].gpio_id = 47;
+	pwm_gpio[2].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH + 20;
+	pwm_gpio[3].gpio_id = 48;
+	pwm_gpio[3].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH + 21;
+
+	// Describe the overall signal and reference the above array.
+	signal_definition->num_gpios = PWM_TEST_NUM_GPIOS;
+	signal_definition->period_in_usecs = period_in_usecs;
+	signal_definition->pwm_signal = pwm_gpio;
+
+	// Send the signal definition to the DSP.
+	if (ioctl(fd, PWM_IOCTL_SIGNAL_DEFINITION, signal_definition) != 0) {
+		return ERROR;
+	}
+
+	return SUCCESS;
+}
+
 /**
 * @brief
 * Test to define PWM signals at a specified period and vary the pulse width.
@@ -58,31 +115,17 @@
 * SUCCESS ------ Test Passes
 * ERROR ------ Test Failed
 */
-
-#define PWM_TEST_PULSE_WIDTH_INCREMENTS 10
-#define PWM_TEST_MINIMUM_PULSE_WIDTH 1050
-#define INCREMENT_PULSE_WIDTH(x,y) ((x + PWM_TEST_PULSE_WIDTH_INCREMENTS) >= y ? PWM_TEST_MINIMUM_PULSE_WIDTH : x + PWM_TEST_PULSE_WIDTH_INCREMENTS)
-
 int dspal_tester_pwm_test(void)
 {
 	int ret = SUCCESS;
-	int pulse_width;
 	int test_count;
-	struct dspal_version_info version;
-	int major_version, minor_version;
-
-	dspal_get_version_info_ext(&version);
-	strtok(version.version_string, "-.");
-	major_version = atoi(strtok(NULL, "-."));
-	minor_version = atoi(strtok(NULL, "-."));
-
-	if (major_version < 1 || (major_version == 1 && minor_version < 1))
-	{
-		LOG_INFO("unable to test PWM signaling, current version: %d.%d, requires version 1.1 or above",
-				major_version, minor_version);
+
+	if (!dspal_tester_is_version_supported(1, 1)) {
+		LOG_INFO("unable to test PWM signaling");
 		return ERROR;
 	}
-	LOG_INFO("testing PWM signaling, DSPAL version: %d.%d", major_version, minor_version);
+
+	LOG_INFO("testing PWM signaling");
 	/*
 	 * Open PWM device
 	 */
@@ -93,30 +136,12 @@ int dspal_tester_pwm_test(void)
 		/*
 		 * Configure PWM device
 		 */
-		struct dspal_pwm pwm_gpio[4];
+		struct dspal_pwm pwm_gpio[PWM_TEST_NUM_GPIOS];
 		struct dspal_pwm_ioctl_signal_definition signal_definition;
 		struct dspal_pwm_ioctl_update_buffer *update_buffer;
 		struct dspal_pwm *pwm;
 
-		// Define the initial pulse width and number of the GPIO to
-		// use for this signal definition.
-		// 45,46,47,48
-		pwm_gpio[0].gpio_id = 45;
-		pwm_gpio[0].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH;
-		pwm_gpio[1].gpio_id = 46;
-		pwm_gpio[1].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH + 10;
-		pwm_gpio[2].gpio_id = 47;
-		pwm_gpio[2].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH + 20;
-		pwm_gpio[3].gpio_id = 48;
-		pwm_gpio[3].pulse_width_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH + 21;
-
-		// Describe the overall signal and reference the above array.
-		signal_definition.num_gpios = 4;
-		signal_definition.period_in_usecs = 2000;
-		signal_definition.pwm_signal = &pwm_gpio[0];
-
-		// Send the signal definition to the DSP.
-		if (ioctl(fd, PWM_IOCTL_SIGNAL_DEFINITION, &signal_definition) != 0) {
+		if (pwm_test_define_signals(fd, PWM_TEST_PERIOD_IN_USECS, pwm_gpio, &signal_definition) != SUCCESS) {
 			ret = ERROR;
 		}
 
@@ -153,3 +178,583 @@ int dspal_tester_pwm_test(void)
 
 	return ret;
 }
+
+/**
+* @brief
+* Test to vary the pulse width of all PWM signals at once using the commit buffer.
+*
+* @par
+* Test:
+* 1) Open the PWM device (/dev/pwm-1) and define the same signals as dspal_tester_pwm_test()
+* 2) Retrieve the commit buffer and check that it matches the signal definition
+* 3) Every 500 msecs, write new pulse widths for all signals to the back buffer and commit them
+* 4) Check that each commit takes effect within two periods, and in a later period than the
+*    previous commit
+* 5) Close the PWM device
+*
+* @return
+* SUCCESS ------ Test Passes
+* ERROR ------ Test Failed
+* TEST_SKIP ------ Test Skipped, the DSPAL version does not support the commit buffer
+*/
+int dspal_tester_pwm_commit_test(void)
+{
+	int ret = SUCCESS;
+	int test_count;
+	int fd = -1;
+	struct dspal_pwm pwm_gpio[PWM_TEST_NUM_GPIOS];
+	struct dspal_pwm_ioctl_signal_definition signal_definition;
+	struct dspal_pwm_commit_buffer *commit_buffer;
+	uint32_t pulse_width[PWM_TEST_NUM_GPIOS];
+	uint32_t *back_buffer;
+	uint32_t seq, period, last_period = 0;
+
+	if (!dspal_tester_is_version_supported(1, 4)) {
+		return TEST_SKIP;
+	}
+
+	fd = open("/dev/pwm-1", 0);
+
+	if (fd < 0) {
+		return ERROR;
+	}
+
+	if (pwm_test_define_signals(fd, PWM_TEST_PERIOD_IN_USECS, pwm_gpio, &signal_definition) != SUCCESS) {
+		LOG_ERR("error: PWM_IOCTL_SIGNAL_DEFINITION failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(fd, PWM_IOCTL_GET_COMMIT_BUFFER, &commit_buffer) != 0 ||
+	    commit_buffer->num_gpios != PWM_TEST_NUM_GPIOS) {
+		LOG_ERR("error: PWM_IOCTL_GET_COMMIT_BUFFER failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	for (int i = 0; i < PWM_TEST_NUM_GPIOS; i++) {
+		pulse_width[i] = pwm_gpio[i].pulse_width_in_usecs;
+	}
+
+	// Wait for the ESC's to ARM:
+	usleep(1000000 * 5); // wait 5 seconds
+
+	// Change the speed of all motors together, every 500 msecs.
+	for (test_count = 0; test_count < 30; test_count++) {
+		back_buffer = dspal_pwm_get_back_buffer(commit_buffer);
+
+		for (int i = 0; i < PWM_TEST_NUM_GPIOS; i++) {
+			pulse_width[i] = INCREMENT_PULSE_WIDTH(pulse_width[i], signal_definition.period_in_usecs);
+			back_buffer[i] = pulse_width[i] * 1000;
+		}
+
+		seq = dspal_pwm_commit(commit_buffer);
+
+		// The commit must take effect at the next period boundary.
+		usleep(2 * signal_definition.period_in_usecs);
+
+		if (!dspal_pwm_get_commit_period(commit_buffer, seq, &period)) {
+			LOG_ERR("error: commit %u did not take effect, period count: %u", seq, commit_buffer->period_count);
+			ret = ERROR;
+			break;
+		}
+
+		if (test_count > 0 && period <= last_period) {
+			LOG_ERR("error: commit %u took effect in period %u, previous commit in period %u", seq, period, last_period);
+			ret = ERROR;
+			break;
+		}
+
+		LOG_DEBUG("commit %u took effect in period %u", seq, period);
+		last_period = period;
+		usleep(1000 * 500);
+	}
+
+exit:
+	close(fd);
+	return ret;
+}
+
+/**
+* @brief
+* Test to generate two groups of PWM signals with different periods at the same time.
+*
+* @par
+* Test:
+* 1) Open the first PWM device (/dev/pwm-1) and check the capabilities of the signal generator
+* 2) Define the same signals as dspal_tester_pwm_test() at a period of 2 msecs
+* 3) Open the second PWM device (/dev/pwm-2) and check that a signal definition using a GPIO
+*    of the first group is rejected
+* 4) Define two servo signals on other GPIO's at a period of 20 msecs
+* 5) Run both groups for one second and check, using the period count of each commit buffer,
+*    that each group was generated at its own period
+* 6) Close both PWM devices
+*
+* @return
+* SUCCESS ------ Test Passes
+* ERROR ------ Test Failed
+* TEST_SKIP ------ Test Skipped, the DSPAL version does not support multiple groups
+*/
+int dspal_tester_pwm_groups_test(void)
+{
+	int ret = SUCCESS;
+	int esc_fd = -1;
+	int servo_fd = -1;
+	struct dspal_pwm esc_gpio[PWM_TEST_NUM_GPIOS];
+	struct dspal_pwm servo_gpio[PWM_TEST_SERVO_NUM_GPIOS];
+	struct dspal_pwm_ioctl_signal_definition esc_definition;
+	struct dspal_pwm_ioctl_signal_definition servo_definition;
+	struct dspal_pwm_ioctl_capabilities capabilities;
+	struct dspal_pwm_commit_buffer *esc_buffer;
+	struct dspal_pwm_commit_buffer *servo_buffer;
+	uint32_t esc_periods, servo_periods;
+
+	if (!dspal_tester_is_version_supported(1, 4)) {
+		return TEST_SKIP;
+	}
+
+	esc_fd = open("/dev/pwm-1", 0);
+	servo_fd = open("/dev/pwm-2", 0);
+
+	if (esc_fd < 0 || servo_fd < 0) {
+		LOG_ERR("error: failed to open both PWM devices");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(esc_fd, PWM_IOCTL_GET_CAPABILITIES, &capabilities) != 0) {
+		LOG_ERR("error: PWM_IOCTL_GET_CAPABILITIES failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	LOG_INFO("PWM capabilities: %u signals, %u groups, period %u-%u usecs, resolution %u nsecs",
+		 capabilities.max_num_signals, capabilities.max_num_groups, capabilities.min_period_in_usecs,
+		 capabilities.max_period_in_usecs, capabilities.resolution_in_nsecs);
+
+	if (capabilities.max_num_signals < DEV_FS_PWM_MAX_NUM_SIGNALS || capabilities.max_num_groups < 2) {
+		LOG_ERR("error: PWM capabilities below the limits defined in dev_fs_lib_pwm.h");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (pwm_test_define_signals(esc_fd, PWM_TEST_PERIOD_IN_USECS, esc_gpio, &esc_definition) != SUCCESS) {
+		LOG_ERR("error: PWM_IOCTL_SIGNAL_DEFINITION failed for the first group");
+		ret = ERROR;
+		goto exit;
+	}
+
+	// A GPIO can only be used by one group.
+	servo_gpio[0].gpio_id = esc_gpio[0].gpio_id;
+	servo_gpio[0].pulse_width_in_usecs = PWM_TEST_SERVO_PULSE_WIDTH;
+	servo_definition.num_gpios = 1;
+	servo_definition.period_in_usecs = PWM_TEST_SERVO_PERIOD_IN_USECS;
+	servo_definition.pwm_signal = servo_gpio;
+
+	if (ioctl(servo_fd, PWM_IOCTL_SIGNAL_DEFINITION, &servo_definition) == 0) {
+		LOG_ERR("error: GPIO %u accepted by two groups", servo_gpio[0].gpio_id);
+		ret = ERROR;
+		goto exit;
+	}
+
+	for (int i = 0; i < PWM_TEST_SERVO_NUM_GPIOS; i++) {
+		servo_gpio[i].gpio_id = PWM_TEST_SERVO_FIRST_GPIO + i;
+		servo_gpio[i].pulse_width_in_usecs = PWM_TEST_SERVO_PULSE_WIDTH;
+	}
+
+	servo_definition.num_gpios = PWM_TEST_SERVO_NUM_GPIOS;
+
+	if (ioctl(servo_fd, PWM_IOCTL_SIGNAL_DEFINITION, &servo_definition) != 0) {
+		LOG_ERR("error: PWM_IOCTL_SIGNAL_DEFINITION failed for the second group");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(esc_fd, PWM_IOCTL_GET_COMMIT_BUFFER, &esc_buffer) != 0 ||
+	    ioctl(servo_fd, PWM_IOCTL_GET_COMMIT_BUFFER, &servo_buffer) != 0) {
+		LOG_ERR("error: PWM_IOCTL_GET_COMMIT_BUFFER failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	// Run both groups for one second.
+	esc_periods = esc_buffer->period_count;
+	servo_periods = servo_buffer->period_count;
+	usleep(1000000);
+	esc_periods = esc_buffer->period_count - esc_periods;
+	servo_periods = servo_buffer->period_count - servo_periods;
+
+	LOG_INFO("periods generated in one second: %u at %u usecs, %u at %u usecs",
+		 esc_periods, esc_definition.period_in_usecs, servo_periods, servo_definition.period_in_usecs);
+
+	// Allow for the time taken by the calls to usleep() and reading the period counts.
+	if (esc_periods < 1000000 / esc_definition.period_in_usecs - 5 ||
+	    esc_periods > 1000000 / esc_definition.period_in_usecs + 5 ||
+	    servo_periods < 1000000 / servo_definition.period_in_usecs - 1 ||
+	    servo_periods > 1000000 / servo_definition.period_in_usecs + 1) {
+		LOG_ERR("error: the number of periods generated does not match the period of each group");
+		ret = ERROR;
+	}
+
+exit:
+	close(servo_fd);
+	close(esc_fd);
+	return ret;
+}
+
+/**
+* @brief
+* Test to send DShot600 frames to bidirectional ESC's at 4 kHz.
+*
+* @par
+* Test:
+* 1) Open the PWM device and select bidirectional DShot600 output
+* 2) Define the same GPIO's as dspal_tester_pwm_test() with a period of 250 usecs, and check
+*    that the output mode can no longer be changed
+* 3) Commit a motor stop frame for every signal, once per period, for one second
+* 4) Check, using the period count of the commit buffer, that frames were sent at 4 kHz
+* 5) Read the telemetry of the ESC's; no reply is required, since ESC's may not be connected
+* 6) Close the PWM device
+*
+* @return
+* SUCCESS ------ Test Passes
+* ERROR ------ Test Failed
+* TEST_SKIP ------ Test Skipped, the DSPAL version does not support DShot
+*/
+int dspal_tester_pwm_dshot_test(void)
+{
+	int ret = SUCCESS;
+	int fd = -1;
+	struct dspal_pwm pwm_gpio[PWM_TEST_NUM_GPIOS];
+	struct dspal_pwm_ioctl_signal_definition signal_definition;
+	struct dspal_pwm_ioctl_output_mode output_mode;
+	struct dspal_pwm_ioctl_dshot_telemetry telemetry;
+	struct dspal_pwm_commit_buffer *commit_buffer;
+	uint32_t *back_buffer;
+	uint32_t frame, periods;
+
+	if (!dspal_tester_is_version_supported(1, 4)) {
+		return TEST_SKIP;
+	}
+
+	fd = open("/dev/pwm-1", 0);
+
+	if (fd < 0) {
+		return ERROR;
+	}
+
+	output_mode.mode = DSPAL_PWM_OUTPUT_MODE_DSHOT600;
+	output_mode.bidirectional = 1;
+	output_mode.min_gap_in_usecs = 0;
+
+	if (ioctl(fd, PWM_IOCTL_SET_OUTPUT_MODE, &output_mode) != 0) {
+		LOG_ERR("error: PWM_IOCTL_SET_OUTPUT_MODE failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (pwm_test_define_signals(fd, PWM_TEST_DSHOT_PERIOD_IN_USECS, pwm_gpio, &signal_definition) != SUCCESS) {
+		LOG_ERR("error: PWM_IOCTL_SIGNAL_DEFINITION failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(fd, PWM_IOCTL_SET_OUTPUT_MODE, &output_mode) != DEV_FS_PWM_ERROR_SIGNALS_ALREADY_DEFINED) {
+		LOG_ERR("error: output mode changed after the signal definition");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(fd, PWM_IOCTL_GET_COMMIT_BUFFER, &commit_buffer) != 0 ||
+	    commit_buffer->num_gpios != PWM_TEST_NUM_GPIOS) {
+		LOG_ERR("error: PWM_IOCTL_GET_COMMIT_BUFFER failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	// Only motor stop frames are sent, so that no motor is started by the test.
+	frame = dspal_dshot_encode_frame(DSPAL_DSHOT_CMD_MOTOR_STOP, 0, output_mode.bidirectional);
+	periods = commit_buffer->period_count;
+
+	for (int count = 0; count < PWM_TEST_DSHOT_NUM_UPDATES; count++) {
+		back_buffer = dspal_pwm_get_back_buffer(commit_buffer);
+
+		for (int i = 0; i < PWM_TEST_NUM_GPIOS; i++) {
+			back_buffer[i] = frame;
+		}
+
+		dspal_pwm_commit(commit_buffer);
+		usleep(PWM_TEST_DSHOT_PERIOD_IN_USECS);
+	}
+
+	periods = commit_buffer->period_count - periods;
+	LOG_INFO("%u DShot frames sent for %u updates", periods, PWM_TEST_DSHOT_NUM_UPDATES);
+
+	// usleep() may sleep longer than requested, but frames are sent at a fixed rate.
+	if (periods < PWM_TEST_DSHOT_NUM_UPDATES) {
+		LOG_ERR("error: DShot frames sent at less than %u Hz", 1000000 / PWM_TEST_DSHOT_PERIOD_IN_USECS);
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(fd, PWM_IOCTL_GET_DSHOT_TELEMETRY, &telemetry) != 0 ||
+	    telemetry.num_gpios != PWM_TEST_NUM_GPIOS) {
+		LOG_ERR("error: PWM_IOCTL_GET_DSHOT_TELEMETRY failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	for (int i = 0; i < PWM_TEST_NUM_GPIOS; i++) {
+		if (telemetry.valid_mask & (1 << i)) {
+			LOG_INFO("GPIO %u: %u eRPM", pwm_gpio[i].gpio_id, dspal_dshot_erpm(telemetry.erpm_period_in_usecs[i]));
+
+		} else {
+			LOG_INFO("GPIO %u: no telemetry reply", pwm_gpio[i].gpio_id);
+		}
+	}
+
+exit:
+	close(fd);
+	return ret;
+}
+
+/**
+* @brief
+* Test to trigger OneShot125 pulses from the control loop.
+*
+* @par
+* Test:
+* 1) Open the PWM device and select OneShot125 output with the default minimum gap
+* 2) Define the same GPIO's as dspal_tester_pwm_test(), repeating the pulses every 2 msecs
+*    if no trigger occurs
+* 3) Commit new pulse widths and trigger them, once per msec, and check that each commit
+*    takes effect when triggered rather than at the next period
+* 4) Trigger twice in a row and check that the second trigger is deferred by the minimum gap
+* 5) Close the PWM device
+*
+* @return
+* SUCCESS ------ Test Passes
+* ERROR ------ Test Failed
+* TEST_SKIP ------ Test Skipped, the DSPAL version does not support triggered output modes
+*/
+int dspal_tester_pwm_oneshot_test(void)
+{
+	int ret = SUCCESS;
+	int fd = -1;
+	struct dspal_pwm pwm_gpio[PWM_TEST_NUM_GPIOS];
+	struct dspal_pwm_ioctl_signal_definition signal_definition;
+	struct dspal_pwm_ioctl_output_mode output_mode;
+	struct dspal_pwm_ioctl_trigger trigger;
+	struct dspal_pwm_commit_buffer *commit_buffer;
+	uint32_t *back_buffer;
+	uint32_t seq, period;
+
+	if (!dspal_tester_is_version_supported(1, 4)) {
+		return TEST_SKIP;
+	}
+
+	fd = open("/dev/pwm-1", 0);
+
+	if (fd < 0) {
+		return ERROR;
+	}
+
+	output_mode.mode = DSPAL_PWM_OUTPUT_MODE_ONESHOT125;
+	output_mode.bidirectional = 0;
+	output_mode.min_gap_in_usecs = 0;
+
+	if (ioctl(fd, PWM_IOCTL_SET_OUTPUT_MODE, &output_mode) != 0) {
+		LOG_ERR("error: PWM_IOCTL_SET_OUTPUT_MODE failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (pwm_test_define_signals(fd, PWM_TEST_PERIOD_IN_USECS, pwm_gpio, &signal_definition) != SUCCESS) {
+		LOG_ERR("error: PWM_IOCTL_SIGNAL_DEFINITION failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(fd, PWM_IOCTL_GET_COMMIT_BUFFER, &commit_buffer) != 0 ||
+	    commit_buffer->num_gpios != PWM_TEST_NUM_GPIOS) {
+		LOG_ERR("error: PWM_IOCTL_GET_COMMIT_BUFFER failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	for (int count = 0; count < PWM_TEST_ONESHOT_NUM_TRIGGERS; count++) {
+		back_buffer = dspal_pwm_get_back_buffer(commit_buffer);
+
+		// Sweep all pulse widths of OneShot125, starting at the minimum pulse width.
+		for (int i = 0; i < PWM_TEST_NUM_GPIOS; i++) {
+			back_buffer[i] = PWM_TEST_ONESHOT125_MIN_PULSE_WIDTH_IN_NSECS +
+					 (count * 1000 + i * 100) % PWM_TEST_ONESHOT125_MIN_PULSE_WIDTH_IN_NSECS;
+		}
+
+		seq = dspal_pwm_commit(commit_buffer);
+
+		if (ioctl(fd, PWM_IOCTL_TRIGGER, &trigger) != 0) {
+			LOG_ERR("error: PWM_IOCTL_TRIGGER failed");
+			ret = ERROR;
+			goto exit;
+		}
+
+		// The pulses of the previous trigger ended at least 750 usecs ago.
+		if (trigger.delay_in_nsecs != 0 || !dspal_pwm_get_commit_period(commit_buffer, seq, &period)) {
+			LOG_ERR("error: trigger %d was not applied immediately, delay: %u nsecs", count, trigger.delay_in_nsecs);
+			ret = ERROR;
+			goto exit;
+		}
+
+		usleep(1000);
+	}
+
+	// The previous pulses are still being sent, so this trigger must wait for them and the gap.
+	if (ioctl(fd, PWM_IOCTL_TRIGGER, NULL) != 0 || ioctl(fd, PWM_IOCTL_TRIGGER, &trigger) != 0) {
+		LOG_ERR("error: PWM_IOCTL_TRIGGER failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	LOG_INFO("trigger deferred by %u nsecs", trigger.delay_in_nsecs);
+
+	if (trigger.delay_in_nsecs == 0) {
+		LOG_ERR("error: second trigger was not deferred by the minimum gap");
+		ret = ERROR;
+	}
+
+exit:
+	close(fd);
+	return ret;
+}
+
+/**
+* @brief
+* Test to change the period of the PWM signals while they are generated, and to read the
+* timing statistics of the signal generator.
+*
+* @par
+* Test:
+* 1) Open the PWM device and define the same signals as dspal_tester_pwm_test()
+* 2) Check that a period shorter than the pulse widths is rejected
+* 3) Alternate the period between 2 and 2.5 msecs, checking that each new period starts
+*    after the period in which it was requested
+* 4) Commit time stamped pulse widths and check that the commit latency is reported
+* 5) Read and reset the statistics, and check that the reset took effect
+* 6) Close the PWM device
+*
+* @return
+* SUCCESS ------ Test Passes
+* ERROR ------ Test Failed
+* TEST_SKIP ------ Test Skipped, the DSPAL version does not support changing the period
+*/
+int dspal_tester_pwm_period_test(void)
+{
+	int ret = SUCCESS;
+	int fd = -1;
+	struct dspal_pwm pwm_gpio[PWM_TEST_NUM_GPIOS];
+	struct dspal_pwm_ioctl_signal_definition signal_definition;
+	struct dspal_pwm_ioctl_period period;
+	struct dspal_pwm_ioctl_stats stats;
+	struct dspal_pwm_commit_buffer *commit_buffer;
+	struct timespec now;
+	uint32_t *back_buffer;
+	uint32_t period_count, seq;
+
+	if (!dspal_tester_is_version_supported(1, 4)) {
+		return TEST_SKIP;
+	}
+
+	fd = open("/dev/pwm-1", 0);
+
+	if (fd < 0) {
+		return ERROR;
+	}
+
+	if (pwm_test_define_signals(fd, PWM_TEST_PERIOD_IN_USECS, pwm_gpio, &signal_definition) != SUCCESS) {
+		LOG_ERR("error: PWM_IOCTL_SIGNAL_DEFINITION failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	if (ioctl(fd, PWM_IOCTL_GET_COMMIT_BUFFER, &commit_buffer) != 0) {
+		LOG_ERR("error: PWM_IOCTL_GET_COMMIT_BUFFER failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	period.period_in_usecs = PWM_TEST_MINIMUM_PULSE_WIDTH - 1;
+
+	if (ioctl(fd, PWM_IOCTL_SET_PERIOD, &period) == 0) {
+		LOG_ERR("error: period of %u usecs accepted for pulses of %u usecs", period.period_in_usecs,
+			PWM_TEST_MINIMUM_PULSE_WIDTH);
+		ret = ERROR;
+		goto exit;
+	}
+
+	for (int count = 0; count < PWM_TEST_NUM_PERIOD_CHANGES; count++) {
+		period.period_in_usecs = (count & 1) ? PWM_TEST_PERIOD_IN_USECS : PWM_TEST_NEW_PERIOD_IN_USECS;
+		period_count = commit_buffer->period_count;
+
+		if (ioctl(fd, PWM_IOCTL_SET_PERIOD, &period) != 0) {
+			LOG_ERR("error: PWM_IOCTL_SET_PERIOD failed for %u usecs", period.period_in_usecs);
+			ret = ERROR;
+			goto exit;
+		}
+
+		// The current period must be completed before the new one starts.
+		if ((int32_t)(period.start_period_count - period_count) <= 0) {
+			LOG_ERR("error: new period starts at period %u, requested in period %u", period.start_period_count,
+				period_count);
+			ret = ERROR;
+			goto exit;
+		}
+
+		usleep(10 * period.period_in_usecs);
+	}
+
+	back_buffer = dspal_pwm_get_back_buffer(commit_buffer);
+
+	for (int i = 0; i < PWM_TEST_NUM_GPIOS; i++) {
+		back_buffer[i] = pwm_gpio[i].pulse_width_in_usecs * 1000;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	dspal_pwm_set_commit_time(commit_buffer, now.tv_sec * 1000000000ULL + now.tv_nsec);
+	seq = dspal_pwm_commit(commit_buffer);
+	usleep(2 * PWM_TEST_PERIOD_IN_USECS);
+
+	stats.reset = 1;
+
+	if (!dspal_pwm_get_commit_period(commit_buffer, seq, &period_count) ||
+	    ioctl(fd, PWM_IOCTL_GET_STATS, &stats) != 0) {
+		LOG_ERR("error: commit not applied or PWM_IOCTL_GET_STATS failed");
+		ret = ERROR;
+		goto exit;
+	}
+
+	LOG_INFO("PWM stats: %u periods, %u late edges, max jitter %u nsecs, commit latency %u nsecs (max %u nsecs)",
+		 stats.periods_generated, stats.late_edges, stats.max_edge_jitter_in_nsecs,
+		 stats.last_commit_latency_in_nsecs, stats.max_commit_latency_in_nsecs);
+
+	// The commit cannot take effect later than the start of the period after the commit.
+	if (stats.periods_generated == 0 || stats.last_commit_latency_in_nsecs == 0 ||
+	    stats.last_commit_latency_in_nsecs > PWM_TEST_PERIOD_IN_USECS * 1000 ||
+	    stats.max_commit_latency_in_nsecs < stats.last_commit_latency_in_nsecs) {
+		LOG_ERR("error: inconsistent PWM stats");
+		ret = ERROR;
+		goto exit;
+	}
+
+	stats.reset = 0;
+
+	if (ioctl(fd, PWM_IOCTL_GET_STATS, &stats) != 0 || stats.periods_generated > 1 ||
+	    stats.max_commit_latency_in_nsecs != 0) {
+		LOG_ERR("error: PWM stats not reset, %u periods since the reset", stats.periods_generated);
+		ret = ERROR;
+	}
+
+exit:
+	close(fd);
+	return ret;
+}
@@ -0,0 +1,239 @@
+/****************************************************************************
+ * Copyright (c) 2026 ATLFlight. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name ATLFlight nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include <dspal_dshot.h>
+
+#include "test_utils.h"
+#include "noarch_test_suite.h"
+
+#define DSHOT_TEST_NUM_SIGNALS 16
+#define DSHOT_TEST_MAX_EVENTS (3 * DSPAL_DSHOT_FRAME_BITS + 1)
+#define DSHOT_TEST_OVERSAMPLING 3
+
+/**
+ * @brief
+ * Records each write to a simulated GPIO output register, as the signal generator
+ * would make them.
+ */
+struct dshot_test_pin_recorder {
+	uint32_t num_events;
+	uint32_t time_in_nsecs[DSHOT_TEST_MAX_EVENTS];
+	uint32_t levels[DSHOT_TEST_MAX_EVENTS]; /**< bit i is the level of signal i after the write */
+};
+
+static void dshot_test_record(struct dshot_test_pin_recorder *recorder, uint32_t time_in_nsecs, uint32_t levels)
+{
+	recorder->time_in_nsecs[recorder->num_events] = time_in_nsecs;
+	recorder->levels[recorder->num_events] = levels;
+	recorder->num_events++;
+}
+
+/**
+ * @brief
+ * Sends a batch of frames in the same way as the signal generator: three writes per bit,
+ * whatever the number of signals.  Bidirectional signals are inverted.
+ */
+static void dshot_test_send_batch(struct dshot_test_pin_recorder *recorder, const struct dspal_dshot_batch *batch,
+				  const struct dspal_dshot_timing *timing, int bidirectional)
+{
+	uint32_t invert = bidirectional ? batch->signal_mask : 0;
+	uint32_t bit, start = 0;
+
+	recorder->num_events = 0;
+	dshot_test_record(recorder, 0, invert);
+
+	for (bit = 0; bit < DSPAL_DSHOT_FRAME_BITS; bit++) {
+		dshot_test_record(recorder, start, batch->signal_mask ^ invert);
+		dshot_test_record(recorder, start + timing->t0h_in_nsecs,
+				  (batch->signal_mask & ~batch->zero_mask[bit]) ^ invert);
+		dshot_test_record(recorder, start + timing->t1h_in_nsecs, invert);
+		start += timing->bit_period_in_nsecs;
+	}
+}
+
+/**
+ * @brief
+ * Receives the frame of one signal from the recorded writes, as done by an ESC: a bit is
+ * a one if its pulse is longer than half of the bit period.
+ *
+ * @return
+ * The frame received, or -1 if the recording does not contain DSPAL_DSHOT_FRAME_BITS pulses
+ * starting one bit period apart.
+ */
+static int32_t dshot_test_receive_frame(const struct dshot_test_pin_recorder *recorder, uint32_t signal,
+					const struct dspal_dshot_timing *timing, int bidirectional)
+{
+	uint32_t mask = 1u << signal;
+	uint32_t invert = bidirectional ? mask : 0;
+	uint32_t previous = 0;
+	uint32_t rise = 0, num_bits = 0;
+	uint32_t frame = 0;
+
+	for (uint32_t i = 0; i < recorder->num_events; i++) {
+		uint32_t level = (recorder->levels[i] ^ invert) & mask;
+
+		if (level == previous) { continue; }
+
+		if (level) {
+			if (num_bits > 0 && recorder->time_in_nsecs[i] - rise != timing->bit_period_in_nsecs) {
+				return -1;
+			}
+
+			rise = recorder->time_in_nsecs[i];
+
+		} else {
+			frame = (frame << 1) | (recorder->time_in_nsecs[i] - rise > timing->bit_period_in_nsecs / 2);
+			num_bits++;
+		}
+
+		previous = level;
+	}
+
+	return (num_bits == DSPAL_DSHOT_FRAME_BITS) ? (int32_t)frame : -1;
+}
+
+/**
+ * @brief
+ * Sends a telemetry reply over a simulated line and samples it at DSHOT_TEST_OVERSAMPLING
+ * times the bit rate, as done by the signal generator after a bidirectional frame.  The line
+ * is idle high and the capture starts sample_offset samples before the start bit.
+ */
+static uint32_t dshot_test_capture_reply(uint32_t reply, uint32_t sample_offset)
+{
+	uint8_t samples[(DSPAL_DSHOT_TELEMETRY_BITS + 2) * DSHOT_TEST_OVERSAMPLING];
+	uint32_t num_samples = sizeof(samples);
+	uint32_t i, start, levels = 0;
+
+	for (i = 0; i < num_samples; i++) {
+		int32_t bit = (int32_t)(i / DSHOT_TEST_OVERSAMPLING) - 1;
+
+		if (i < sample_offset || bit < 0 || bit >= DSPAL_DSHOT_TELEMETRY_BITS) {
+			samples[i] = 1;
+
+		} else {
+			// Levels are read as 1 when the line is low.
+			samples[i] = !((reply >> (DSPAL_DSHOT_TELEMETRY_BITS - 1 - bit)) & 1);
+		}
+	}
+
+	// Find the start bit, then sample in the middle of each bit.
+	for (start = 0; start < num_samples && samples[start]; start++) {}
+
+	for (i = 0; i < DSPAL_DSHOT_TELEMETRY_BITS; i++) {
+		uint32_t sample = start + i * DSHOT_TEST_OVERSAMPLING + DSHOT_TEST_OVERSAMPLING / 2;
+
+		levels = (levels << 1) | (sample < num_samples ? !samples[sample] : 0);
+	}
+
+	return levels;
+}
+
+int noarch_test_dshot_codec(void)
+{
+	static const uint32_t bit_rates[] = { 150, 300, 600 };
+	static const uint32_t periods[] = { 1, 100, 511, 512, 1000, 4000, 30000, DSPAL_DSHOT_ERPM_PERIOD_STOPPED };
+	struct dshot_test_pin_recorder recorder;
+	struct dspal_dshot_timing timing;
+	struct dspal_dshot_batch batch;
+	uint32_t frames[DSHOT_TEST_NUM_SIGNALS];
+	uint32_t throttle, period;
+	int telemetry;
+
+	// 1046 without telemetry: 10000010110 0 0110
+	if (dspal_dshot_encode_frame(1046, 0, 0) != 0x82C6) {
+		FAIL("frame of a known throttle value is incorrect");
+	}
+
+	for (uint32_t bit = 0; bit < DSPAL_DSHOT_FRAME_BITS; bit++) {
+		if (dspal_dshot_decode_frame(0x82C6 ^ (1u << bit), 0, &throttle, &telemetry) == 0) {
+			FAIL("single bit error not detected by the CRC");
+		}
+	}
+
+	for (uint32_t rate = 0; rate < sizeof(bit_rates) / sizeof(bit_rates[0]); rate++) {
+		for (int bidirectional = 0; bidirectional <= 1; bidirectional++) {
+			dspal_dshot_get_timing(bit_rates[rate], &timing);
+
+			for (uint32_t i = 0; i < DSHOT_TEST_NUM_SIGNALS; i++) {
+				frames[i] = dspal_dshot_encode_frame((i * 137 + rate * 500) % (DSPAL_DSHOT_MAX_THROTTLE + 1),
+								     i & 1, bidirectional);
+			}
+
+			dspal_dshot_encode_batch(frames, DSHOT_TEST_NUM_SIGNALS, &batch);
+			dshot_test_send_batch(&recorder, &batch, &timing, bidirectional);
+
+			for (uint32_t i = 0; i < DSHOT_TEST_NUM_SIGNALS; i++) {
+				int32_t frame = dshot_test_receive_frame(&recorder, i, &timing, bidirectional);
+
+				if (frame < 0 || dspal_dshot_decode_frame(frame, bidirectional, &throttle, &telemetry) != 0 ||
+				    throttle != (i * 137 + rate * 500) % (DSPAL_DSHOT_MAX_THROTTLE + 1) ||
+				    telemetry != (int)(i & 1)) {
+					LOG_ERR("DShot%u%s signal %u received 0x%x, sent 0x%x", bit_rates[rate],
+						bidirectional ? " bidirectional" : "", i, frame, frames[i]);
+					FAIL("frame not received correctly");
+				}
+			}
+
+			// A frame of the wrong type must be rejected by the ESC.
+			if (dspal_dshot_decode_frame(frames[0], !bidirectional, &throttle, &telemetry) == 0) {
+				FAIL("frame accepted with the CRC of the other DShot type");
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+		uint32_t reply = dspal_dshot_encode_telemetry(periods[i]);
+
+		for (uint32_t offset = 0; offset < DSHOT_TEST_OVERSAMPLING; offset++) {
+			uint32_t levels = dshot_test_capture_reply(reply, offset);
+
+			// Periods over 511 usecs lose their least significant bits.
+			if (levels != reply || dspal_dshot_decode_telemetry(levels, &period) != 0 ||
+			    period > periods[i] || periods[i] - period > (periods[i] >> 8)) {
+				LOG_ERR("telemetry reply of %u usecs captured as 0x%x, sent 0x%x", periods[i], levels, reply);
+				FAIL("telemetry reply not received correctly");
+			}
+		}
+
+		if (dspal_dshot_decode_telemetry(reply ^ (1u << (i + 3)), &period) == 0) {
+			FAIL("corrupted telemetry reply not rejected");
+		}
+	}
+
+	if (dspal_dshot_erpm(1000) != 60000 || dspal_dshot_erpm(DSPAL_DSHOT_ERPM_PERIOD_STOPPED) != 0) {
+		FAIL("incorrect eRPM conversion");
+	}
+
+	return TEST_PASS;
+}
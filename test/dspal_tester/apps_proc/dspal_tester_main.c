@@ -45,6 +45,7 @@
 #include "dspal_tester.h"
 #include "posix_test_suite.h"
 #include "io_test_suite.h"
+#include "noarch_test_suite.h"
 
   
 static char *main_help =
@@ -58,6 +59,7 @@ static char *main_help =
         "\t--timers    | -t       timer functionality \n"
         "\t--core      | -c       includes pthreas and timers \n"
         "\t--devices   | -d       I/O basic tests \n"   
+        "\t--noarch    | -n       portable header tests, run on the application processor \n"
         "\t--all       | -a       includes all above tests \n"
         "\t--uart      | -u       uart loopback testing - not yet supported\n"
         "\t--gpio      | -g       gpio loopback testing - not yet supported\n"
@@ -69,13 +71,14 @@ static struct option main_long_opts[] = {
         { "timers",   0, 0, 't' },
         { "core",     0, 0, 'c' },
         { "devices",  0, 0, 'd' },
+        { "noarch",   0, 0, 'n' },
         { "all",      0, 0, 'a' },
         { "uart",     0, 0, 'u' },
         { "gpio",     0, 0, 'g' },
         { 0, 0, 0, 0 }
 };
 
-static char main_short_opts[] = "hptcdaug";
+static char main_short_opts[] = "hptcdnaug";
 
 /**
  * @brief Runs all the tests requested at the command line
@@ -98,6 +101,7 @@ int main(int argc, char *argv[])
     int pthreads      = 0; 
     int timers        = 0;  
     int devices       = 0;
+    int noarch        = 0;
 
     int i = 1; 
     
@@ -106,6 +110,7 @@ int main(int argc, char *argv[])
        pthreads = 1; 
        timers   = 1; 
        devices  = 1; 
+       noarch   = 1; 
     }
 
     while ((opt = getopt_long(argc, argv, main_short_opts, main_long_opts, NULL)) != -1) {
@@ -119,6 +124,9 @@ int main(int argc, char *argv[])
             case 'p':
                 pthreads = 1; 
                 break;
+            case 'n':
+                noarch = 1; 
+                break;
 
             case 'c':
                 /*Core means pthreads + timers*/
@@ -130,6 +138,7 @@ int main(int argc, char *argv[])
                 pthreads = 1; 
                 timers   = 1; 
                 devices  = 1; 
+                noarch   = 1; 
                 break;
 
             case 'u':
@@ -152,6 +161,7 @@ int main(int argc, char *argv[])
          pthreads = 1; 
          timers   = 1; 
          devices  = 1; 
+         noarch   = 1; 
     }
 
 	LOG_INFO("Starting DSPAL tests");
@@ -173,6 +183,11 @@ int main(int argc, char *argv[])
         status |= run_io_test_suite();
     }
 
+    if ( noarch ) {
+        LOG_INFO("Starting DSPAL portable header tests");
+        status |= run_noarch_test_suite();
+    }
+
     if ( uart_loopback ) {
         LOG_INFO("DSPAL uart loopback test not supported");
         status |= TEST_SKIP; 
@@ -50,6 +50,11 @@ int run_io_test_suite()
 #if defined(DSP_TYPE_ADSP)
 	LOG_INFO("testing PWM signaling");
 	test_results |= display_test_results( dspal_tester_pwm_test(), "pwm_test");
+	test_results |= display_test_results( dspal_tester_pwm_commit_test(), "pwm commit test");
+	test_results |= display_test_results( dspal_tester_pwm_groups_test(), "pwm groups test");
+	test_results |= display_test_results( dspal_tester_pwm_dshot_test(), "pwm dshot test");
+	test_results |= display_test_results( dspal_tester_pwm_oneshot_test(), "pwm oneshot test");
+	test_results |= display_test_results( dspal_tester_pwm_period_test(), "pwm period test");
 #endif
 
     LOG_INFO("testing FARF");
@@ -61,6 +66,7 @@ int run_io_test_suite()
 	test_results |= display_test_results( dspal_tester_test_gpio_open_close(), "gpio open/close test");
 	test_results |= display_test_results( dspal_tester_test_gpio_ioctl_io(), "gpio ioctl I/O mode test");
 	test_results |= display_test_results( dspal_tester_test_gpio_read_write(), "gpio read/write test");
+	test_results |= display_test_results( dspal_tester_test_gpio_fast_handle(), "gpio fast handle test");
 
 #if !defined(DSP_TYPE_SLPI)	
 	test_results |= display_test_results( dspal_tester_test_gpio_int(), "gpio INT test");
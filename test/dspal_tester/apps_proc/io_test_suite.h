@@ -43,22 +43,28 @@
  *  2) serial I/O test (dspal_tester_serial_test)
  *  3) i2c test (dspal_tester_i2c_test)
  *  4) pwm_test (dspal_tester_pwm_test)
- *  5) farf log_info test (dspal_tester_test_farf_log_info)
- *  6) farf log_err test (dspal_tester_test_farf_log_err)
- *  7) farf log_debug test (dspal_tester_test_farf_log_debug)
- *  8) gpio open/close test (dspal_tester_test_gpio_open_close)
- *  9) gpio ioctl I/O mode test (dspal_tester_test_gpio_ioctl_io)
- * 10) gpio read/write test (dspal_tester_test_gpio_read_write)
- * 11) gpio INT test (dspal_tester_test_gpio_int)
- * 12) file open/close (dspal_tester_test_posix_file_open_close)
- * 13) file read/write (dspal_tester_test_posix_file_read_write)
- * 14) file open_trunc (dspal_tester_test_posix_file_open_trunc)
- * 15) file open_append (dspal_tester_test_posix_file_open_append)
- * 16) file ioctl (dspal_tester_test_posix_file_ioctl)
- * 17) file fsync (dspal_tester_test_posix_file_fsync)
- * 18) file remove (dspal_tester_test_posix_file_remove)
- * 19) fopen/fclose test (dspal_tester_test_fopen_fclose)
- * 20) fwrite/fread test (dspal_tester_test_fwrite_fread)
+ *  5) pwm commit test (dspal_tester_pwm_commit_test)
+ *  6) pwm groups test (dspal_tester_pwm_groups_test)
+ *  7) pwm dshot test (dspal_tester_pwm_dshot_test)
+ *  8) pwm oneshot test (dspal_tester_pwm_oneshot_test)
+ *  9) pwm period test (dspal_tester_pwm_period_test)
+ * 10) farf log_info test (dspal_tester_test_farf_log_info)
+ * 11) farf log_err test (dspal_tester_test_farf_log_err)
+ * 12) farf log_debug test (dspal_tester_test_farf_log_debug)
+ * 13) gpio open/close test (dspal_tester_test_gpio_open_close)
+ * 14) gpio ioctl I/O mode test (dspal_tester_test_gpio_ioctl_io)
+ * 15) gpio read/write test (dspal_tester_test_gpio_read_write)
+ * 16) gpio fast handle test (dspal_tester_test_gpio_fast_handle)
+ * 17) gpio INT test (dspal_tester_test_gpio_int)
+ * 18) file open/close (dspal_tester_test_posix_file_open_close)
+ * 19) file read/write (dspal_tester_test_posix_file_read_write)
+ * 20) file open_trunc (dspal_tester_test_posix_file_open_trunc)
+ * 21) file open_append (dspal_tester_test_posix_file_open_append)
+ * 22) file ioctl (dspal_tester_test_posix_file_ioctl)
+ * 23) file fsync (dspal_tester_test_posix_file_fsync)
+ * 24) file remove (dspal_tester_test_posix_file_remove)
+ * 25) fopen/fclose test (dspal_tester_test_fopen_fclose)
+ * 26) fwrite/fread test (dspal_tester_test_fwrite_fread)
  *
  * @return
  * TEST_PASS ------ All tests passed
@@ -0,0 +1,102 @@
+/****************************************************************************
+ * Copyright (c) 2026 ATLFlight. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name ATLFlight nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef NOARCH_TEST_SUITE_H_
+#define NOARCH_TEST_SUITE_H_
+
+/**
+ * @brief Tests of the DShot encoder and decoder in dspal_dshot.h.
+ *
+ * @par
+ * Test:
+ * 1) Check the frame of a known throttle value and that a single bit error is detected
+ * 2) Send the frames of 16 signals through a simulated GPIO, recording each change of the
+ *    output register, at each bit rate, with and without bidirectional DShot
+ * 3) Decode the recorded signals by the width of each pulse, as done by an ESC, and check
+ *    the frames received
+ * 4) Send telemetry replies through a simulated line, sample them and check the period
+ *    decoded, and that a corrupted reply is rejected
+ *
+ * @return
+ * TEST_PASS ------ Test Passes
+ * TEST_FAIL ------ Test Failed
+*/
+int noarch_test_dshot_codec(void);
+
+/**
+ * @brief Tests of the timing wheel in dspal_timer_wheel.h.
+ *
+ * @par
+ * Test:
+ * 1) Check that an empty wheel reports no timer
+ * 2) Arm and disarm random timers, from the next tick to beyond the range of the wheel,
+ *    and advance the wheel by random numbers of ticks
+ * 3) After each change, check that the next tick is not after the earliest expiry
+ * 4) After each advance, check that every timer that expired was returned once, in order,
+ *    and that no other timer was returned
+ *
+ * @return
+ * TEST_PASS ------ Test Passes
+ * TEST_FAIL ------ Test Failed
+*/
+int noarch_test_timer_wheel(void);
+
+/**
+ * @brief Benchmark of the timing wheel in dspal_timer_wheel.h.
+ *
+ * @par
+ * For 10, 100, 1000 and 10000 armed timers, measures the time taken to disarm and arm a
+ * timer, and to expire and rearm a periodic timer.  The cost should not depend on the number
+ * of timers.
+ *
+ * @return
+ * TEST_PASS ------ Benchmark completed
+ * TEST_FAIL ------ Timers were lost by the wheel
+*/
+int noarch_benchmark_timer_wheel(void);
+
+/**
+ * @brief Runs the tests of the portable headers in include/noarch on the application
+ * processor.
+ *
+ * @par
+ * Tests that are run (in order)
+ *  1) dshot codec test (noarch_test_dshot_codec)
+ *  2) timer wheel test (noarch_test_timer_wheel)
+ *
+ * @return
+ * TEST_PASS ------ All tests passed
+ * TEST_FAIL ------ One or more tests failed
+*/
+int run_noarch_test_suite();
+
+#endif /* NOARCH_TEST_SUITE_H_ */
@@ -0,0 +1,232 @@
+/****************************************************************************
+ * Copyright (c) 2026 ATLFlight. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name ATLFlight nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <dspal_timer_wheel.h>
+
+#include "test_utils.h"
+#include "noarch_test_suite.h"
+
+#define TIMER_WHEEL_TEST_NUM_TIMERS 1000
+#define TIMER_WHEEL_TEST_NUM_STEPS 20000
+#define TIMER_WHEEL_BENCHMARK_MAX_TIMERS 10000
+#define TIMER_WHEEL_BENCHMARK_NUM_OPERATIONS 100000
+#define TIMER_WHEEL_BENCHMARK_MAX_EXPIRY 1000000
+
+/**
+ * @brief
+ * Timer of the tests below, with the entry as first member.
+ */
+struct timer_wheel_test_timer {
+	struct dspal_timer_wheel_entry entry;
+	uint64_t expiry;  /**< expected expiry, 0 if not armed */
+};
+
+static struct timer_wheel_test_timer timer_wheel_test_timers[TIMER_WHEEL_BENCHMARK_MAX_TIMERS];
+
+/**
+ * @brief
+ * Returns a random expiry after now: mostly within level 0 and 1, sometimes beyond the range
+ * of the wheel.
+ */
+static uint64_t timer_wheel_test_random_expiry(uint64_t now)
+{
+	switch (rand() % 4) {
+	case 0:
+		return now + rand() % 64;
+
+	case 1:
+		return now + rand() % 5000;
+
+	case 2:
+		return now + ((uint64_t)rand() << 4) % (1ULL << 24);
+
+	default:
+		return now + (1ULL << 24) + ((uint64_t)rand() << 8) % (1ULL << 30);
+	}
+}
+
+int noarch_test_timer_wheel(void)
+{
+	static struct dspal_timer_wheel wheel;
+	struct timer_wheel_test_timer *timers = timer_wheel_test_timers;
+	struct dspal_timer_wheel_entry *entry;
+	uint64_t now = (1ULL << 24) - 1000;
+	uint64_t last_expiry = 0;
+	uint64_t next, earliest;
+	uint32_t num_armed = 0;
+	uint32_t num_expired = 0;
+
+	srand(1);
+	dspal_timer_wheel_init(&wheel, now);
+
+	if (dspal_timer_wheel_next_tick(&wheel, &next) || dspal_timer_wheel_expire(&wheel, now + 1000) != NULL) {
+		FAIL("empty wheel reported a timer");
+	}
+
+	now += 1000;
+
+	for (uint32_t i = 0; i < TIMER_WHEEL_TEST_NUM_TIMERS; i++) {
+		dspal_timer_wheel_entry_init(&timers[i].entry);
+		timers[i].expiry = 0;
+	}
+
+	for (uint32_t step = 0; step < TIMER_WHEEL_TEST_NUM_STEPS; step++) {
+		// Arm or disarm a few timers, then advance by a random number of ticks.
+		for (int change = 0; change < 4; change++) {
+			struct timer_wheel_test_timer *timer = &timers[rand() % TIMER_WHEEL_TEST_NUM_TIMERS];
+
+			if (timer->expiry != 0) {
+				dspal_timer_wheel_remove(&wheel, &timer->entry);
+				timer->expiry = 0;
+				num_armed--;
+
+			} else {
+				timer->expiry = timer_wheel_test_random_expiry(now);
+				dspal_timer_wheel_add(&wheel, &timer->entry, timer->expiry);
+				num_armed++;
+			}
+		}
+
+		earliest = UINT64_MAX;
+
+		for (uint32_t i = 0; i < TIMER_WHEEL_TEST_NUM_TIMERS; i++) {
+			if (timers[i].expiry != 0 && timers[i].expiry < earliest) { earliest = timers[i].expiry; }
+		}
+
+		// The hardware timer must never be programmed after the earliest expiry.
+		if (wheel.num_entries != num_armed || (num_armed > 0 && (!dspal_timer_wheel_next_tick(&wheel, &next) ||
+				next > earliest))) {
+			FAIL("next tick after the earliest expiry");
+		}
+
+		now += (step % 100 == 0) ? (uint64_t)rand() << 6 : (uint64_t)(rand() % 200);
+		last_expiry = 0;
+
+		while ((entry = dspal_timer_wheel_expire(&wheel, now)) != NULL) {
+			struct timer_wheel_test_timer *timer = (struct timer_wheel_test_timer *)entry;
+
+			if (timer->expiry == 0 || timer->expiry > now || timer->expiry < last_expiry ||
+			    dspal_timer_wheel_is_armed(entry)) {
+				LOG_ERR("timer expiring at %llu returned at %llu", (unsigned long long)timer->expiry,
+					(unsigned long long)now);
+				FAIL("timer expired out of order");
+			}
+
+			last_expiry = timer->expiry;
+			timer->expiry = 0;
+			num_armed--;
+			num_expired++;
+		}
+
+		for (uint32_t i = 0; i < TIMER_WHEEL_TEST_NUM_TIMERS; i++) {
+			if (timers[i].expiry != 0 && timers[i].expiry <= now) {
+				FAIL("expired timer not returned");
+			}
+		}
+	}
+
+	LOG_DEBUG("%u timers expired, %u armed", num_expired, num_armed);
+
+	return TEST_PASS;
+}
+
+static uint64_t timer_wheel_benchmark_nsecs(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+int noarch_benchmark_timer_wheel(void)
+{
+	static struct dspal_timer_wheel wheel;
+	struct timer_wheel_test_timer *timers = timer_wheel_test_timers;
+	struct dspal_timer_wheel_entry *entry;
+	uint64_t start, rearm_nsecs, expire_nsecs;
+	uint64_t now;
+	uint32_t num_expired;
+
+	srand(1);
+
+	for (uint32_t num_timers = 10; num_timers <= TIMER_WHEEL_BENCHMARK_MAX_TIMERS; num_timers *= 10) {
+		now = 0;
+		dspal_timer_wheel_init(&wheel, now);
+
+		for (uint32_t i = 0; i < num_timers; i++) {
+			dspal_timer_wheel_entry_init(&timers[i].entry);
+			dspal_timer_wheel_add(&wheel, &timers[i].entry, 1 + rand() % TIMER_WHEEL_BENCHMARK_MAX_EXPIRY);
+		}
+
+		// Disarm and arm again, as done by a timeout that is restarted.
+		start = timer_wheel_benchmark_nsecs();
+
+		for (uint32_t i = 0; i < TIMER_WHEEL_BENCHMARK_NUM_OPERATIONS; i++) {
+			struct timer_wheel_test_timer *timer = &timers[i % num_timers];
+
+			dspal_timer_wheel_remove(&wheel, &timer->entry);
+			dspal_timer_wheel_add(&wheel, &timer->entry, 1 + (i * 7919) % TIMER_WHEEL_BENCHMARK_MAX_EXPIRY);
+		}
+
+		rearm_nsecs = timer_wheel_benchmark_nsecs() - start;
+
+		// Expire every timer once, rearming it as a periodic timer.
+		num_expired = 0;
+		start = timer_wheel_benchmark_nsecs();
+
+		while (num_expired < num_timers) {
+			uint64_t next;
+
+			if (!dspal_timer_wheel_next_tick(&wheel, &next)) { break; }
+
+			while ((entry = dspal_timer_wheel_expire(&wheel, next)) != NULL) {
+				dspal_timer_wheel_add(&wheel, entry, entry->expiry + TIMER_WHEEL_BENCHMARK_MAX_EXPIRY);
+				num_expired++;
+			}
+		}
+
+		expire_nsecs = timer_wheel_benchmark_nsecs() - start;
+
+		if (num_expired < num_timers || wheel.num_entries != num_timers) {
+			FAIL("timers lost by the wheel");
+		}
+
+		LOG_INFO("timer wheel, %5u timers: disarm + arm %llu ns, expire + rearm %llu ns", num_timers,
+			 (unsigned long long)(rearm_nsecs / TIMER_WHEEL_BENCHMARK_NUM_OPERATIONS),
+			 (unsigned long long)(expire_nsecs / num_expired));
+	}
+
+	return TEST_PASS;
+}
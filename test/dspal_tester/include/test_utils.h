@@ -66,5 +66,8 @@ const char *get_result_string(int result);
 
 void test_failed(const char *msg, const char *file, int lineNumber);
 
+/* Only available to the tests running on the DSP. */
+int dspal_tester_is_version_supported(int required_major, int required_minor);
+
 time_t time(time_t *t);
 __END_DECLS